@@ -0,0 +1,210 @@
+#!/usr/bin/env node
+// 本地性能测试：启动 Vite 开发服务器，用本机 Chrome 无头打开 bench.html，
+// 收集页面上报的结果并保存为 bench-results/<commit>.json。不需要网络，也不引入额外依赖。
+//
+//   node scripts/bench-runner.mjs [--script autoplay|jump] [--frames 1800] [--warmup 120]
+//                                 [--seed 42] [--runs 1] [--baseline <commit|file>]
+//
+// 浏览器路径可通过环境变量 CHROME_PATH 指定。
+import { spawn, execFileSync } from 'node:child_process'
+import { existsSync, mkdirSync, mkdtempSync, readFileSync, rmSync, writeFileSync } from 'node:fs'
+import { tmpdir } from 'node:os'
+import { dirname, join, resolve } from 'node:path'
+import { fileURLToPath } from 'node:url'
+import { createServer } from 'vite'
+
+const root = resolve(dirname(fileURLToPath(import.meta.url)), '..')
+const resultsDir = join(root, 'bench-results')
+const RESULTS_ENDPOINT = '/__bench/results'
+const TIMEOUT_MS = 120000
+
+function parseArgs(argv) {
+  const options = { script: 'autoplay', frames: 1800, warmup: 120, seed: 42, runs: 1, baseline: null }
+  for (let i = 0; i < argv.length; i++) {
+    const name = argv[i].replace(/^--/, '')
+    if (!(name in options) || i + 1 >= argv.length) {
+      console.error(`未知参数: ${argv[i]}`)
+      process.exit(2)
+    }
+    const value = argv[++i]
+    options[name] = typeof options[name] === 'number' ? Number(value) : value
+  }
+  return options
+}
+
+function currentCommit() {
+  try {
+    const git = (...args) => execFileSync('git', args, { cwd: root, encoding: 'utf8' }).trim()
+    const commit = git('rev-parse', '--short', 'HEAD')
+    return git('status', '--porcelain', '--untracked-files=no') ? `${commit}-dirty` : commit
+  } catch {
+    return 'unknown'
+  }
+}
+
+function findChrome() {
+  const candidates = [
+    process.env.CHROME_PATH,
+    '/usr/bin/google-chrome',
+    '/usr/bin/google-chrome-stable',
+    '/usr/bin/chromium',
+    '/usr/bin/chromium-browser',
+    '/Applications/Google Chrome.app/Contents/MacOS/Google Chrome',
+    'C:\\Program Files\\Google\\Chrome\\Application\\chrome.exe',
+    'C:\\Program Files (x86)\\Google\\Chrome\\Application\\chrome.exe',
+  ]
+  return candidates.find((path) => path && existsSync(path)) ?? null
+}
+
+// 开发服务器中间件：接收页面 POST 的结果 JSON
+function benchResultsPlugin(onResult) {
+  return {
+    name: 'bench-results',
+    configureServer(server) {
+      server.middlewares.use(RESULTS_ENDPOINT, (req, res) => {
+        let body = ''
+        req.on('data', (chunk) => (body += chunk))
+        req.on('end', () => {
+          res.statusCode = 204
+          res.end()
+          try {
+            onResult(JSON.parse(body))
+          } catch (error) {
+            onResult({ error: `结果解析失败: ${error.message}` })
+          }
+        })
+      })
+    },
+  }
+}
+
+async function runOnce(chrome, options, commit) {
+  let deliver
+  const received = new Promise((resolvePromise) => (deliver = resolvePromise))
+
+  const server = await createServer({
+    root,
+    configFile: join(root, 'vite.config.ts'),
+    logLevel: 'warn',
+    server: { port: 0, strictPort: false, host: '127.0.0.1' },
+    plugins: [benchResultsPlugin(deliver)],
+  })
+  await server.listen()
+  const address = server.httpServer.address()
+
+  const query = new URLSearchParams({
+    script: options.script,
+    frames: String(options.frames),
+    warmup: String(options.warmup),
+    seed: String(options.seed),
+    commit,
+  })
+  const url = `http://127.0.0.1:${address.port}/bench.html?${query}`
+
+  const profileDir = mkdtempSync(join(tmpdir(), 'dino-bench-'))
+  const browser = spawn(
+    chrome,
+    [
+      '--headless=new',
+      '--no-first-run',
+      '--no-default-browser-check',
+      '--disable-extensions',
+      '--disable-background-timer-throttling',
+      '--disable-renderer-backgrounding',
+      '--enable-precise-memory-info', // performance.memory 不做量化，GC 估算才准确
+      `--user-data-dir=${profileDir}`,
+      url,
+    ],
+    { stdio: 'ignore' },
+  )
+
+  const timeout = new Promise((resolvePromise) =>
+    setTimeout(() => resolvePromise({ error: `等待结果超时（${TIMEOUT_MS}ms）` }), TIMEOUT_MS),
+  )
+  const exited = new Promise((resolvePromise) =>
+    browser.on('exit', (code) => resolvePromise({ error: `浏览器提前退出（code ${code}）` })),
+  )
+
+  try {
+    return await Promise.race([received, timeout, exited])
+  } finally {
+    browser.kill()
+    await server.close()
+    rmSync(profileDir, { recursive: true, force: true })
+  }
+}
+
+// 多次运行时取各分位数的中位数，降低单次抖动的影响
+function mergeRuns(runs) {
+  if (runs.length === 1) return runs[0]
+
+  const median = (values) => [...values].sort((a, b) => a - b)[Math.floor(values.length / 2)]
+  const merged = structuredClone(runs[0])
+  for (const key of ['frameInterval', 'update', 'render']) {
+    for (const stat of ['mean', 'p50', 'p95', 'p99', 'max']) {
+      merged[key][stat] = median(runs.map((run) => run[key][stat]))
+    }
+  }
+  merged.timeToFirstFrameMs = median(runs.map((run) => run.timeToFirstFrameMs))
+  merged.runs = runs.length
+  return merged
+}
+
+function loadBaseline(baseline, suffix) {
+  const path = existsSync(baseline) ? baseline : join(resultsDir, `${baseline}${suffix}.json`)
+  if (!existsSync(path)) {
+    console.error(`找不到基线结果: ${baseline}`)
+    return null
+  }
+  return JSON.parse(readFileSync(path, 'utf8'))
+}
+
+function printSummary(result, baseline) {
+  const delta = (current, previous) => {
+    if (previous === undefined || previous === 0) return ''
+    const percent = ((current - previous) / previous) * 100
+    return ` (${percent >= 0 ? '+' : ''}${percent.toFixed(1)}%)`
+  }
+
+  console.log(`commit ${result.commit}  script=${result.config.script}  frames=${result.config.frames}`)
+  console.log(`  time to first frame  ${result.timeToFirstFrameMs} ms${delta(result.timeToFirstFrameMs, baseline?.timeToFirstFrameMs)}`)
+  for (const key of ['frameInterval', 'update', 'render']) {
+    const line = ['p50', 'p95', 'p99']
+      .map((stat) => `${stat} ${result[key][stat]}${delta(result[key][stat], baseline?.[key]?.[stat])}`)
+      .join('  ')
+    console.log(`  ${key.padEnd(20)} ${line}  (ms)`)
+  }
+  console.log(`  long tasks           ${result.longTasks.count} (${result.longTasks.totalMs} ms)`)
+  console.log(`  gc (heap drops)      ${result.gc.count} (${result.gc.freedBytes} bytes)`)
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2))
+  const chrome = findChrome()
+  if (!chrome) {
+    console.error('未找到 Chrome/Chromium，请通过 CHROME_PATH 指定浏览器路径')
+    process.exit(1)
+  }
+
+  const commit = currentCommit()
+  const runs = []
+  for (let i = 0; i < options.runs; i++) {
+    const result = await runOnce(chrome, options, commit)
+    if (result.error) {
+      console.error(result.error)
+      process.exit(1)
+    }
+    runs.push(result)
+  }
+
+  const result = mergeRuns(runs)
+  mkdirSync(resultsDir, { recursive: true })
+  const suffix = options.script === 'autoplay' ? '' : `-${options.script}`
+  const outPath = join(resultsDir, `${commit}${suffix}.json`)
+  writeFileSync(outPath, JSON.stringify(result, null, 2) + '\n')
+
+  printSummary(result, options.baseline ? loadBaseline(options.baseline, suffix) : null)
+  console.log(`结果已写入 ${outPath}`)
+}
+
+main()
@@ -0,0 +1,389 @@
+#!/usr/bin/env node
+// 精灵图集打包：只把 assets/atlas.json 中列出的精灵区域从原始精灵图拷贝到一张紧凑的图集，
+// 并从同一份描述生成 C++ 与 TS 两边的图集常量。只依赖 node 自带的 zlib。
+//
+//   node scripts/pack-atlas.mjs          生成 public/atlas.png、src/core/atlas.generated.ts、
+//                                        game-core/include/SpriteAtlas.hpp
+//   node scripts/pack-atlas.mjs --check  只检查生成的文件是否与描述一致（不一致时退出码为 1）
+//
+// atlas.json：
+//   sprites  名称 -> { x, y, w, h, frames?, stride? }，原始精灵图中的区域；多帧精灵的第 i 帧位于
+//            x + i * stride，打包后各帧仍在同一行，间距为图集中的 stride
+//   strips   名称 -> { x, y, w, h }，横向很长的条带（地面），按图集宽度切成若干段依次摆放
+//   padding  精灵之间留出的透明像素，避免缩放绘制时采样到相邻精灵
+//   maxSlices 条带最多切成几段（每段每帧多一条绘制命令）
+import { readFileSync, writeFileSync } from 'node:fs'
+import { dirname, join, relative, resolve } from 'node:path'
+import { fileURLToPath } from 'node:url'
+import { deflateSync, inflateSync } from 'node:zlib'
+
+const root = resolve(dirname(fileURLToPath(import.meta.url)), '..')
+const descriptionPath = join(root, 'assets', 'atlas.json')
+const outputs = {
+  png: join(root, 'public', 'atlas.png'),
+  ts: join(root, 'src', 'core', 'atlas.generated.ts'),
+  cpp: join(root, '..', 'game-core', 'include', 'SpriteAtlas.hpp'),
+}
+
+// ============ PNG 读写（只支持调色板图像，原始精灵图为 4 位调色板） ============
+
+const PNG_SIGNATURE = Buffer.from([0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a])
+
+function paeth(a, b, c) {
+  const p = a + b - c
+  const pa = Math.abs(p - a)
+  const pb = Math.abs(p - b)
+  const pc = Math.abs(p - c)
+  return pa <= pb && pa <= pc ? a : pb <= pc ? b : c
+}
+
+function decodePng(buffer) {
+  if (!buffer.subarray(0, 8).equals(PNG_SIGNATURE)) throw new Error('不是 PNG 文件')
+
+  let header = null
+  let palette = null
+  let transparency = null
+  const data = []
+  for (let pos = 8; pos < buffer.length; ) {
+    const length = buffer.readUInt32BE(pos)
+    const type = buffer.toString('latin1', pos + 4, pos + 8)
+    const chunk = buffer.subarray(pos + 8, pos + 8 + length)
+    pos += 12 + length
+
+    if (type === 'IHDR') {
+      header = {
+        width: chunk.readUInt32BE(0),
+        height: chunk.readUInt32BE(4),
+        bitDepth: chunk[8],
+        colorType: chunk[9],
+        interlace: chunk[12],
+      }
+    } else if (type === 'PLTE') {
+      palette = Buffer.from(chunk)
+    } else if (type === 'tRNS') {
+      transparency = Buffer.from(chunk)
+    } else if (type === 'IDAT') {
+      data.push(chunk)
+    }
+  }
+
+  if (!header || header.colorType !== 3 || header.interlace !== 0 || header.bitDepth > 8) {
+    throw new Error('只支持非隔行扫描的调色板 PNG')
+  }
+
+  const { width, height, bitDepth } = header
+  const stride = Math.ceil((width * bitDepth) / 8)
+  const raw = inflateSync(Buffer.concat(data))
+  const pixels = new Uint8Array(width * height)
+  const mask = (1 << bitDepth) - 1
+
+  let previous = new Uint8Array(stride)
+  for (let y = 0; y < height; y++) {
+    const filter = raw[y * (stride + 1)]
+    const line = Uint8Array.from(raw.subarray(y * (stride + 1) + 1, (y + 1) * (stride + 1)))
+    for (let i = 0; i < stride; i++) {
+      const a = i > 0 ? line[i - 1] : 0
+      const b = previous[i]
+      const c = i > 0 ? previous[i - 1] : 0
+      if (filter === 1) line[i] = (line[i] + a) & 0xff
+      else if (filter === 2) line[i] = (line[i] + b) & 0xff
+      else if (filter === 3) line[i] = (line[i] + ((a + b) >> 1)) & 0xff
+      else if (filter === 4) line[i] = (line[i] + paeth(a, b, c)) & 0xff
+    }
+    for (let x = 0; x < width; x++) {
+      const bit = x * bitDepth
+      pixels[y * width + x] = (line[bit >> 3] >> (8 - bitDepth - (bit & 7))) & mask
+    }
+    previous = line
+  }
+
+  return { width, height, bitDepth, palette, transparency, pixels }
+}
+
+const CRC_TABLE = new Uint32Array(256).map((_, n) => {
+  let c = n
+  for (let k = 0; k < 8; k++) c = c & 1 ? 0xedb88320 ^ (c >>> 1) : c >>> 1
+  return c >>> 0
+})
+
+function crc32(bytes) {
+  let crc = 0xffffffff
+  for (const byte of bytes) crc = CRC_TABLE[(crc ^ byte) & 0xff] ^ (crc >>> 8)
+  return (crc ^ 0xffffffff) >>> 0
+}
+
+function pngChunk(type, data) {
+  const chunk = Buffer.alloc(12 + data.length)
+  chunk.writeUInt32BE(data.length, 0)
+  chunk.write(type, 4, 'latin1')
+  data.copy(chunk, 8)
+  chunk.writeUInt32BE(crc32(chunk.subarray(4, 8 + data.length)), 8 + data.length)
+  return chunk
+}
+
+function encodePng(image) {
+  const { width, height, bitDepth, palette, transparency, pixels } = image
+  const stride = Math.ceil((width * bitDepth) / 8)
+
+  // 每行选择绝对值和最小的过滤方式（libpng 的常用启发式）
+  const raw = Buffer.alloc(height * (stride + 1))
+  let previous = new Uint8Array(stride)
+  for (let y = 0; y < height; y++) {
+    const line = new Uint8Array(stride)
+    for (let x = 0; x < width; x++) {
+      const bit = x * bitDepth
+      line[bit >> 3] |= pixels[y * width + x] << (8 - bitDepth - (bit & 7))
+    }
+
+    let best = null
+    let bestScore = Infinity
+    for (let filter = 0; filter <= 4; filter++) {
+      const filtered = new Uint8Array(stride)
+      let score = 0
+      for (let i = 0; i < stride; i++) {
+        const a = i > 0 ? line[i - 1] : 0
+        const b = previous[i]
+        const c = i > 0 ? previous[i - 1] : 0
+        const predictor = [0, a, b, (a + b) >> 1, paeth(a, b, c)][filter]
+        filtered[i] = (line[i] - predictor) & 0xff
+        score += filtered[i] < 128 ? filtered[i] : 256 - filtered[i]
+      }
+      if (score < bestScore) {
+        bestScore = score
+        best = { filter, filtered }
+      }
+    }
+
+    raw[y * (stride + 1)] = best.filter
+    raw.set(best.filtered, y * (stride + 1) + 1)
+    previous = line
+  }
+
+  const header = Buffer.alloc(13)
+  header.writeUInt32BE(width, 0)
+  header.writeUInt32BE(height, 4)
+  header[8] = bitDepth
+  header[9] = 3 // 调色板
+
+  return Buffer.concat([
+    PNG_SIGNATURE,
+    pngChunk('IHDR', header),
+    pngChunk('PLTE', palette),
+    ...(transparency ? [pngChunk('tRNS', transparency)] : []),
+    pngChunk('IDAT', deflateSync(raw, { level: 9 })),
+    pngChunk('IEND', Buffer.alloc(0)),
+  ])
+}
+
+// ============ 打包 ============
+
+// 货架式装箱：按高度从高到低逐行摆放
+function shelfPack(items, width, padding) {
+  const placed = []
+  let x = padding
+  let y = padding
+  let shelfHeight = 0
+  for (const item of items) {
+    if (x + item.w + padding > width) {
+      x = padding
+      y += shelfHeight + padding
+      shelfHeight = 0
+    }
+    placed.push({ ...item, ax: x, ay: y })
+    x += item.w + padding
+    shelfHeight = Math.max(shelfHeight, item.h)
+  }
+  return { placed, height: y + shelfHeight + padding }
+}
+
+function buildItems(description, width) {
+  const padding = description.padding
+  const items = []
+
+  for (const [name, sprite] of Object.entries(description.sprites)) {
+    const frames = sprite.frames ?? 1
+    items.push({
+      name,
+      kind: 'sprite',
+      source: sprite,
+      frames,
+      w: frames * sprite.w + (frames - 1) * padding,
+      h: sprite.h,
+    })
+  }
+
+  // 条带按可用宽度切段，段在图集中各自独立摆放
+  const maxSlice = width - 2 * padding
+  for (const [name, strip] of Object.entries(description.strips)) {
+    for (let offset = 0, index = 0; offset < strip.w; offset += maxSlice, index++) {
+      const w = Math.min(maxSlice, strip.w - offset)
+      items.push({
+        name,
+        kind: 'slice',
+        index,
+        source: { x: strip.x + offset, y: strip.y, w, h: strip.h },
+        frames: 1,
+        w,
+        h: strip.h,
+      })
+    }
+  }
+
+  return items.sort((a, b) => b.h - a.h || b.w - a.w)
+}
+
+// 在所有可行宽度中选面积最小的布局（相同时取较窄的）
+function packAtlas(description) {
+  const padding = description.padding
+  const widest = Math.max(...Object.values(description.sprites).map((s) => (s.frames ?? 1) * (s.w + padding)))
+  const longest = Math.max(...Object.values(description.strips).map((s) => s.w))
+  const narrowest = Math.max(widest, Math.ceil(longest / (description.maxSlices ?? 1)))
+
+  let best = null
+  for (let width = narrowest + 2 * padding; width <= longest + 2 * padding; width++) {
+    const { placed, height } = shelfPack(buildItems(description, width), width, padding)
+    if (!best || width * height < best.width * best.height) {
+      best = { width, height, placed }
+    }
+  }
+  return best
+}
+
+function blit(source, atlas, sx, sy, dx, dy, w, h) {
+  for (let y = 0; y < h; y++) {
+    const from = (sy + y) * source.width + sx
+    atlas.pixels.set(source.pixels.subarray(from, from + w), (dy + y) * atlas.width + dx)
+  }
+}
+
+// ============ 生成常量 ============
+
+const GENERATED_NOTE = '由 fronted/scripts/pack-atlas.mjs 根据 fronted/assets/atlas.json 生成，请勿手动修改'
+
+function generateCpp(layout, sprites, slices) {
+  const lines = [
+    `// ${GENERATED_NOTE}`,
+    '#ifndef SPRITEATLAS_HPP',
+    '#define SPRITEATLAS_HPP',
+    '',
+    '// 图集中的一个精灵；多帧精灵的各帧在同一行，第 i 帧位于 x + i * stride',
+    'struct AtlasSprite {',
+    '    int x, y, w, h;',
+    '    int stride;',
+    '};',
+    '',
+    `constexpr int ATLAS_WIDTH = ${layout.width};`,
+    `constexpr int ATLAS_HEIGHT = ${layout.height};`,
+    '',
+  ]
+  for (const sprite of sprites) {
+    lines.push(
+      `constexpr AtlasSprite ATLAS_${sprite.name} = {${sprite.x}, ${sprite.y}, ${sprite.w}, ${sprite.h}, ${sprite.stride}};`,
+    )
+  }
+  for (const [name, list] of Object.entries(slices)) {
+    lines.push(
+      '',
+      `// ${name} 条带按顺序切成的段，依次首尾相接即为完整条带`,
+      `constexpr int ATLAS_${name}_SLICE_COUNT = ${list.length};`,
+      `constexpr AtlasSprite ATLAS_${name}_SLICES[ATLAS_${name}_SLICE_COUNT] = {`,
+      ...list.map((s) => `    {${s.x}, ${s.y}, ${s.w}, ${s.h}, ${s.w}},`),
+      '};',
+    )
+  }
+  lines.push('', '#endif // SPRITEATLAS_HPP', '')
+  return lines.join('\n')
+}
+
+function generateTs(layout, sprites, slices) {
+  const rect = (s) => `{ x: ${s.x}, y: ${s.y}, w: ${s.w}, h: ${s.h}, stride: ${s.stride} }`
+  const lines = [
+    `// ${GENERATED_NOTE}`,
+    '',
+    'export interface AtlasSprite {',
+    '  x: number',
+    '  y: number',
+    '  w: number',
+    '  h: number',
+    '  stride: number // 多帧精灵相邻帧的间距',
+    '}',
+    '',
+    `export const ATLAS = { URL: 'atlas.png', WIDTH: ${layout.width}, HEIGHT: ${layout.height} }`,
+    '',
+    'export const ATLAS_SPRITES: Record<string, AtlasSprite> = {',
+    ...sprites.map((s) => `  ${s.name}: ${rect(s)},`),
+    '}',
+  ]
+  for (const [name, list] of Object.entries(slices)) {
+    lines.push('', `export const ATLAS_${name}_SLICES: AtlasSprite[] = [`, ...list.map((s) => `  ${rect(s)},`), ']')
+  }
+  lines.push('')
+  return lines.join('\n')
+}
+
+// ============ 主流程 ============
+
+function main() {
+  const check = process.argv.includes('--check')
+  const description = JSON.parse(readFileSync(descriptionPath, 'utf8'))
+  const source = decodePng(readFileSync(join(dirname(descriptionPath), description.source)))
+
+  const layout = packAtlas(description)
+  const atlas = {
+    width: layout.width,
+    height: layout.height,
+    bitDepth: source.bitDepth,
+    palette: source.palette,
+    transparency: source.transparency,
+    pixels: new Uint8Array(layout.width * layout.height), // 调色板 0 号为透明色
+  }
+
+  const sprites = []
+  const slices = {}
+  for (const item of layout.placed) {
+    const src = item.source
+    if (item.kind === 'slice') {
+      blit(source, atlas, src.x, src.y, item.ax, item.ay, src.w, src.h)
+      ;(slices[item.name] ??= [])[item.index] = { x: item.ax, y: item.ay, w: src.w, h: src.h, stride: src.w }
+      continue
+    }
+
+    const atlasStride = src.w + description.padding
+    for (let frame = 0; frame < item.frames; frame++) {
+      blit(source, atlas, src.x + frame * (src.stride ?? 0), src.y, item.ax + frame * atlasStride, item.ay, src.w, src.h)
+    }
+    sprites.push({ name: item.name, x: item.ax, y: item.ay, w: src.w, h: src.h, stride: item.frames > 1 ? atlasStride : 0 })
+  }
+  // 按描述中的顺序输出，便于阅读与比较
+  const order = Object.keys(description.sprites)
+  sprites.sort((a, b) => order.indexOf(a.name) - order.indexOf(b.name))
+
+  const files = [
+    [outputs.png, encodePng(atlas)],
+    [outputs.ts, Buffer.from(generateTs(layout, sprites, slices))],
+    [outputs.cpp, Buffer.from(generateCpp(layout, sprites, slices))],
+  ]
+
+  if (check) {
+    const stale = files.filter(([path, content]) => {
+      try {
+        return !readFileSync(path).equals(content)
+      } catch {
+        return true
+      }
+    })
+    for (const [path] of stale) console.error(`需要重新生成: ${relative(root, path)}`)
+    process.exit(stale.length > 0 ? 1 : 0)
+  }
+
+  for (const [path, content] of files) writeFileSync(path, content)
+
+  const sourcePixels = source.width * source.height
+  const atlasPixels = atlas.width * atlas.height
+  console.log(
+    `atlas ${atlas.width}x${atlas.height} (${((atlasPixels / sourcePixels) * 100).toFixed(1)}% of ` +
+      `${source.width}x${source.height} pixels), ${files[0][1].length} bytes PNG`,
+  )
+}
+
+main()
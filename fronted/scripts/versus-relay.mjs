@@ -0,0 +1,224 @@
+#!/usr/bin/env node
+// 双人竞速的本地中继：最小的 WebSocket 服务器（只用 Node 内置模块），
+// 把发来 {type:'join'} 的客户端两两配对，发给双方同一个种子，之后原样转发二进制输入包。
+// 协议见 src/wasm/versusTransport.ts。
+//
+//   node scripts/versus-relay.mjs [--port 8787]
+//
+// 然后两个浏览器窗口分别打开 http://localhost:5173/?versus=ws://localhost:8787
+import { createHash, randomInt } from 'node:crypto'
+import { createServer } from 'node:http'
+
+const WS_GUID = '258EAFA5-E914-47DA-95CA-C5AB0DC85B11'
+const MAX_PAYLOAD = 64 * 1024 // 输入包最大 72 字节，控制消息也很短
+
+const OPCODE_TEXT = 0x1
+const OPCODE_BINARY = 0x2
+const OPCODE_CLOSE = 0x8
+const OPCODE_PING = 0x9
+const OPCODE_PONG = 0xa
+
+function parseArgs(argv) {
+  const options = { port: 8787 }
+  for (let i = 0; i < argv.length; i++) {
+    const name = argv[i].replace(/^--/, '')
+    if (!(name in options) || i + 1 >= argv.length) {
+      console.error(`未知参数: ${argv[i]}`)
+      process.exit(2)
+    }
+    options[name] = Number(argv[++i])
+  }
+  return options
+}
+
+// 服务器发出的帧不加掩码
+function encodeFrame(opcode, payload) {
+  const length = payload.length
+  let header
+  if (length < 126) {
+    header = Buffer.from([0x80 | opcode, length])
+  } else if (length < 65536) {
+    header = Buffer.alloc(4)
+    header[0] = 0x80 | opcode
+    header[1] = 126
+    header.writeUInt16BE(length, 2)
+  } else {
+    header = Buffer.alloc(10)
+    header[0] = 0x80 | opcode
+    header[1] = 127
+    header.writeBigUInt64BE(BigInt(length), 2)
+  }
+  return Buffer.concat([header, payload])
+}
+
+// 从缓冲区头部解析一帧；数据不完整时返回 null。客户端发来的帧必须带掩码
+function decodeFrame(buffer) {
+  if (buffer.length < 2) return null
+  const fin = (buffer[0] & 0x80) !== 0
+  const opcode = buffer[0] & 0x0f
+  const masked = (buffer[1] & 0x80) !== 0
+  let length = buffer[1] & 0x7f
+  let offset = 2
+
+  if (length === 126) {
+    if (buffer.length < 4) return null
+    length = buffer.readUInt16BE(2)
+    offset = 4
+  } else if (length === 127) {
+    if (buffer.length < 10) return null
+    const big = buffer.readBigUInt64BE(2)
+    length = big > BigInt(MAX_PAYLOAD) ? MAX_PAYLOAD + 1 : Number(big)
+    offset = 10
+  }
+  if (!masked || length > MAX_PAYLOAD) return { error: true }
+  if (buffer.length < offset + 4 + length) return null
+
+  const mask = buffer.subarray(offset, offset + 4)
+  const payload = Buffer.from(buffer.subarray(offset + 4, offset + 4 + length))
+  for (let i = 0; i < payload.length; i++) {
+    payload[i] ^= mask[i & 3]
+  }
+  return { fin, opcode, payload, size: offset + 4 + length }
+}
+
+class Client {
+  constructor(socket, id) {
+    this.socket = socket
+    this.id = id
+    this.buffer = Buffer.alloc(0)
+    this.peer = null
+  }
+
+  send(opcode, payload) {
+    if (!this.socket.destroyed) {
+      this.socket.write(encodeFrame(opcode, payload))
+    }
+  }
+
+  sendJson(message) {
+    this.send(OPCODE_TEXT, Buffer.from(JSON.stringify(message)))
+  }
+
+  close() {
+    this.send(OPCODE_CLOSE, Buffer.alloc(0))
+    this.socket.end()
+  }
+}
+
+const options = parseArgs(process.argv.slice(2))
+let waiting = null
+let nextId = 1
+
+// 断开连接：移出等待队列，对手收到 peer-left
+function leave(client) {
+  if (waiting === client) waiting = null
+  if (client.peer) {
+    client.peer.sendJson({ type: 'peer-left' })
+    client.peer.peer = null
+    client.peer = null
+  }
+}
+
+// 静默解除配对：对手可能还在跑上一局，它已收到本方全部输入，不需要通知
+function unpair(client) {
+  if (client.peer?.peer === client) client.peer.peer = null
+  client.peer = null
+}
+
+// 请求下一局：排队期间继续与上一局的对手互相转发输入，配上新对手时才解除旧的配对
+function join(client) {
+  if (waiting === client) return
+  if (!waiting) {
+    waiting = client
+    return
+  }
+  const opponent = waiting
+  waiting = null
+  unpair(opponent)
+  unpair(client)
+  client.peer = opponent
+  opponent.peer = client
+  const seed = randomInt(0x100000000)
+  opponent.sendJson({ type: 'start', seed })
+  client.sendJson({ type: 'start', seed })
+  console.log(`配对 #${opponent.id} 与 #${client.id}，种子 ${seed}`)
+}
+
+function handleFrame(client, frame) {
+  // 浏览器不会把这么短的消息分片，分片帧直接当作协议错误
+  if (!frame.fin) {
+    client.close()
+    return
+  }
+  switch (frame.opcode) {
+    case OPCODE_TEXT: {
+      let message
+      try {
+        message = JSON.parse(frame.payload.toString('utf8'))
+      } catch {
+        return
+      }
+      if (message.type === 'join') join(client)
+      break
+    }
+    case OPCODE_BINARY:
+      client.peer?.send(OPCODE_BINARY, frame.payload)
+      break
+    case OPCODE_PING:
+      client.send(OPCODE_PONG, frame.payload)
+      break
+    case OPCODE_CLOSE:
+      client.close()
+      break
+  }
+}
+
+const server = createServer((req, res) => {
+  res.writeHead(426, { 'Content-Type': 'text/plain; charset=utf-8' })
+  res.end('versus relay: 请用 WebSocket 连接\n')
+})
+
+server.on('upgrade', (req, socket) => {
+  const key = req.headers['sec-websocket-key']
+  if (req.headers.upgrade?.toLowerCase() !== 'websocket' || !key) {
+    socket.end('HTTP/1.1 400 Bad Request\r\n\r\n')
+    return
+  }
+
+  const accept = createHash('sha1').update(key + WS_GUID).digest('base64')
+  socket.write(
+    'HTTP/1.1 101 Switching Protocols\r\n' +
+      'Upgrade: websocket\r\n' +
+      'Connection: Upgrade\r\n' +
+      `Sec-WebSocket-Accept: ${accept}\r\n\r\n`,
+  )
+  socket.setNoDelay(true) // 输入包很小，不等 Nagle 合并
+
+  const client = new Client(socket, nextId++)
+  console.log(`#${client.id} 已连接`)
+
+  socket.on('data', (chunk) => {
+    client.buffer = Buffer.concat([client.buffer, chunk])
+    for (;;) {
+      const frame = decodeFrame(client.buffer)
+      if (!frame) break
+      if (frame.error) {
+        client.close()
+        return
+      }
+      client.buffer = client.buffer.subarray(frame.size)
+      handleFrame(client, frame)
+    }
+  })
+  // HTTP 服务器的连接允许半关闭，对方关闭后这边也要关闭
+  socket.on('end', () => socket.end())
+  socket.on('close', () => {
+    leave(client)
+    console.log(`#${client.id} 已断开`)
+  })
+  socket.on('error', () => socket.destroy())
+})
+
+server.listen(options.port, () => {
+  console.log(`对战中继已启动: ws://localhost:${options.port}`)
+})
@@ -0,0 +1,180 @@
+import { gameBridge } from '../wasm/gameBridge'
+import { frameTiming } from '../core/frameTiming'
+
+// 性能测试脚本：用固定种子和固定输入驱动游戏，统计每帧耗时，结果以 JSON 输出，便于跨提交对比。
+//   autoplay - 内核自动跳跃（不会死亡，测的是稳定运行时的开销）
+//   jump     - 按固定种子的伪随机节奏跳跃，死亡后立即重开（包含重开、游戏结束等路径）
+export type BenchScript = 'autoplay' | 'jump'
+
+export interface BenchConfig {
+  script: BenchScript
+  frames: number // 采样帧数
+  warmup: number // 开始采样前丢弃的帧数（JIT 预热、精灵图解码等）
+  seed: number
+  commit: string // 由运行脚本传入，页面本身不知道当前提交
+}
+
+export interface Distribution {
+  count: number
+  mean: number
+  p50: number
+  p95: number
+  p99: number
+  max: number
+}
+
+export interface BenchResult {
+  commit: string
+  timestamp: string
+  userAgent: string
+  config: BenchConfig
+  timeToFirstFrameMs: number
+  frameInterval: Distribution
+  update: Distribution // _game_update
+  render: Distribution // renderGame
+  longTasks: { count: number; totalMs: number; maxMs: number }
+  gc: { count: number; freedBytes: number } // 根据 JS 堆使用量下降估算
+  restarts: number
+  finalScore: number
+  memory: ReturnType<typeof gameBridge.getMemoryStats>
+}
+
+export const RESULTS_ENDPOINT = '/__bench/results'
+
+export function parseBenchConfig(search: string): BenchConfig {
+  const params = new URLSearchParams(search)
+  const positive = (name: string, fallback: number) => {
+    const value = Number(params.get(name))
+    return Number.isFinite(value) && value > 0 ? Math.floor(value) : fallback
+  }
+
+  return {
+    script: params.get('script') === 'jump' ? 'jump' : 'autoplay',
+    frames: positive('frames', 1800),
+    warmup: positive('warmup', 120),
+    seed: positive('seed', 42),
+    commit: params.get('commit') ?? 'unknown',
+  }
+}
+
+export function distribution(values: number[]): Distribution {
+  if (values.length === 0) {
+    return { count: 0, mean: 0, p50: 0, p95: 0, p99: 0, max: 0 }
+  }
+
+  const sorted = Float64Array.from(values).sort()
+  // 最近秩法：第 ceil(q*n) 个样本
+  const percentile = (q: number) => sorted[Math.max(0, Math.ceil(q * sorted.length) - 1)]
+  const round = (value: number) => Math.round(value * 1000) / 1000
+
+  let sum = 0
+  for (const value of sorted) sum += value
+
+  return {
+    count: sorted.length,
+    mean: round(sum / sorted.length),
+    p50: round(percentile(0.5)),
+    p95: round(percentile(0.95)),
+    p99: round(percentile(0.99)),
+    max: round(sorted[sorted.length - 1]),
+  }
+}
+
+const nextFrame = () => new Promise<number>((resolve) => requestAnimationFrame(resolve))
+
+export async function runBenchmark(config: BenchConfig): Promise<BenchResult | null> {
+  const output = document.getElementById('bench-results')
+
+  // 长任务（> 50ms）由浏览器上报，从页面加载开始收集
+  const longTasks: number[] = []
+  if (PerformanceObserver.supportedEntryTypes?.includes('longtask')) {
+    new PerformanceObserver((list) => {
+      for (const entry of list.getEntries()) longTasks.push(entry.duration)
+    }).observe({ type: 'longtask', buffered: true })
+  }
+
+  // GameCanvas 在精灵图加载完成后才初始化 WASM，这里等待它完成
+  const bootDeadline = performance.now() + 30000
+  while (!gameBridge.isReady()) {
+    if (performance.now() > bootDeadline) {
+      const message = 'WASM 模块初始化超时'
+      if (output) output.textContent = message
+      await postResults({ error: message, config })
+      return null
+    }
+    await nextFrame()
+  }
+
+  gameBridge.setSeed(config.seed)
+  gameBridge.restart()
+  gameBridge.setAutoplay(config.script === 'autoplay')
+  gameBridge.start()
+
+  // 线性同余发生器，保证 jump 脚本每次输入序列相同
+  let rng = config.seed >>> 0
+  const random = () => {
+    rng = (Math.imul(rng, 1664525) + 1013904223) >>> 0
+    return rng / 4294967296
+  }
+
+  let restarts = 0
+  const total = config.warmup + config.frames
+  for (let frame = 0; frame < total; frame++) {
+    if (frame === config.warmup) {
+      frameTiming.reset()
+    }
+
+    if (gameBridge.isGameOver()) {
+      gameBridge.restart()
+      gameBridge.start()
+      restarts++
+    } else if (config.script === 'jump' && random() < 0.04) {
+      gameBridge.jump()
+    }
+
+    await nextFrame()
+  }
+
+  const samples = frameTiming.samples
+  const result: BenchResult = {
+    commit: config.commit,
+    timestamp: new Date().toISOString(),
+    userAgent: navigator.userAgent,
+    config,
+    timeToFirstFrameMs: Math.round(samples.firstFrameAt * 1000) / 1000,
+    frameInterval: distribution(samples.frameIntervals),
+    update: distribution(samples.updateTimes),
+    render: distribution(samples.renderTimes),
+    longTasks: {
+      count: longTasks.length,
+      totalMs: Math.round(longTasks.reduce((sum, value) => sum + value, 0)),
+      maxMs: Math.round(Math.max(0, ...longTasks)),
+    },
+    gc: {
+      count: samples.heapDrops.length,
+      freedBytes: samples.heapDrops.reduce((sum, value) => sum + value, 0),
+    },
+    restarts,
+    finalScore: gameBridge.getScore(),
+    memory: gameBridge.getMemoryStats(),
+  }
+
+  gameBridge.setAutoplay(false)
+
+  if (output) output.textContent = JSON.stringify(result, null, 2)
+  await postResults(result)
+  return result
+}
+
+// 交给 bench-runner 的开发服务器中间件保存；直接 npm run dev 打开页面时没有这个接口，只在页面上显示结果
+async function postResults(body: unknown): Promise<void> {
+  try {
+    await fetch(RESULTS_ENDPOINT, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify(body),
+    })
+  } catch {
+    // 忽略
+  }
+}
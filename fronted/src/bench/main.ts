@@ -0,0 +1,16 @@
+import { createApp } from 'vue'
+import { createPinia } from 'pinia'
+import App from '../App.vue'
+import { frameTiming } from '../core/frameTiming'
+import { parseBenchConfig, runBenchmark } from './harness'
+
+// 挂载前打开采样，首帧时间从页面起点开始计算
+frameTiming.enabled = true
+
+const app = createApp(App)
+
+app.use(createPinia())
+
+app.mount('#app')
+
+runBenchmark(parseBenchConfig(window.location.search))
@@ -0,0 +1,29 @@
+// 由 fronted/scripts/pack-atlas.mjs 根据 fronted/assets/atlas.json 生成，请勿手动修改
+
+export interface AtlasSprite {
+  x: number
+  y: number
+  w: number
+  h: number
+  stride: number // 多帧精灵相邻帧的间距
+}
+
+export const ATLAS = { URL: 'atlas.png', WIDTH: 964, HEIGHT: 164 }
+
+export const ATLAS_SPRITES: Record<string, AtlasSprite> = {
+  DINO_RUN_1: { x: 104, y: 2, w: 88, h: 94, stride: 0 },
+  DINO_RUN_2: { x: 194, y: 2, w: 88, h: 94, stride: 0 },
+  DINO_JUMP: { x: 284, y: 2, w: 88, h: 94, stride: 0 },
+  DINO_DEAD: { x: 374, y: 2, w: 88, h: 94, stride: 0 },
+  DINO_DUCK_1: { x: 724, y: 2, w: 118, h: 60, stride: 0 },
+  DINO_DUCK_2: { x: 844, y: 2, w: 118, h: 60, stride: 0 },
+  CACTUS_SMALL: { x: 652, y: 2, w: 34, h: 70, stride: 36 },
+  CACTUS_BIG: { x: 2, y: 2, w: 49, h: 100, stride: 51 },
+  BIRD: { x: 464, y: 2, w: 92, h: 80, stride: 94 },
+}
+
+export const ATLAS_GROUND_SLICES: AtlasSprite[] = [
+  { x: 2, y: 104, w: 960, h: 18, stride: 960 },
+  { x: 2, y: 124, w: 960, h: 18, stride: 960 },
+  { x: 2, y: 144, w: 484, h: 18, stride: 484 },
+]
@@ -1,34 +1,59 @@
+import { ATLAS_SPRITES, ATLAS_GROUND_SLICES } from './atlas.generated'
+
 // 游戏物理参数
 export const GRAVITY = 1.5 // 重力（与C++同步）
 export const JUMP_FORCE = -38 // 跳跃力度（与C++同步）
 export const INITIAL_GAME_SPEED = 13 // 初始速度（与C++同步）
 export const MAX_GAME_SPEED = 30
 
-// 游戏对象尺寸（基于精灵图）
+// 游戏对象尺寸（精灵位置均为图集坐标，见 atlas.generated.ts）
 export const DINO = {
   WIDTH: 89,
   HEIGHT: 94,
+  DUCK_WIDTH: 118,
+  DUCK_HEIGHT: 60,
   SPRITES: {
-    RUN_1: { x: 1514, y: 0, w: 88, h: 94 },
-    RUN_2: { x: 1602, y: 0, w: 88, h: 94 },
-    JUMP: { x: 1338, y: 0, w: 88, h: 94 },
-    DEAD: { x: 1788, y: 0, w: 88, h: 94 }, // 游戏结束特化模型
+    RUN_1: ATLAS_SPRITES.DINO_RUN_1,
+    RUN_2: ATLAS_SPRITES.DINO_RUN_2,
+    JUMP: ATLAS_SPRITES.DINO_JUMP,
+    DEAD: ATLAS_SPRITES.DINO_DEAD, // 游戏结束特化模型
+    DUCK_1: ATLAS_SPRITES.DINO_DUCK_1,
+    DUCK_2: ATLAS_SPRITES.DINO_DUCK_2,
   },
 }
 
-export const OBSTACLES = {
-  SMALL: {
-    WIDTH: 34,
-    HEIGHT: 70,
-    SPRITE_X: 446,
-    SPRITE_Y: 2,
-  },
-  BIG: {
-    WIDTH: 49,
-    HEIGHT: 100,
-    SPRITE_X: 652,
-    SPRITE_Y: 2,
-  },
+// 障碍物种类（与 C++ ObstacleKind 同步，即原型表下标）
+export enum ObstacleKind {
+  SMALL = 0,
+  BIG = 1,
+  BIRD_LOW = 2,
+  BIRD_MID = 3,
+  BIRD_HIGH = 4,
+}
+
+// 障碍物原型表（与 C++ ObstacleConstants::ARCHETYPES 同步，按 ObstacleKind 索引）
+export const OBSTACLE_ARCHETYPES = [
+  { SPRITE: ATLAS_SPRITES.CACTUS_SMALL, ALTITUDE: 0 },
+  { SPRITE: ATLAS_SPRITES.CACTUS_BIG, ALTITUDE: 0 },
+  { SPRITE: ATLAS_SPRITES.BIRD, ALTITUDE: 20 },
+  { SPRITE: ATLAS_SPRITES.BIRD, ALTITUDE: 50 },
+  { SPRITE: ATLAS_SPRITES.BIRD, ALTITUDE: 100 },
+]
+
+// 地面条带（在图集中切成若干段，按顺序首尾相接）
+export const GROUND = {
+  SLICES: ATLAS_GROUND_SLICES,
+  WIDTH: 2404,
+  HEIGHT: 18,
+}
+
+// 内核绘制列表格式（与 C++ RenderList.hpp 同步）
+// 每条命令: [spriteX, spriteY, spriteW, spriteH, destX, destY, destW, destH, layer]
+export const RENDER_COMMAND_STRIDE = 9
+export const RENDER_LAYER = {
+  GROUND: 0,
+  OBSTACLE: 1,
+  DINO: 2,
 }
 
 // 游戏区域
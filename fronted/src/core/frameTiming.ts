@@ -0,0 +1,73 @@
+// 帧耗时采样（只在性能测试页 bench.html 中开启，正常游戏时每帧只多一次布尔判断）
+
+interface HeapInfo {
+  usedJSHeapSize: number
+}
+
+export interface FrameSamples {
+  frameIntervals: number[] // 相邻两帧 rAF 时间戳之差
+  updateTimes: number[] // gameBridge.update（即 _game_update）耗时
+  renderTimes: number[] // renderGame 耗时
+  heapDrops: number[] // JS 堆使用量下降的字节数（近似 GC 事件）
+  firstFrameAt: number // 首次绘制内核画面的时刻（相对页面起点，毫秒），未绘制时为 -1
+}
+
+class FrameTiming {
+  enabled = false
+  samples: FrameSamples = FrameTiming.emptySamples()
+
+  private lastTimestamp = -1
+  private lastHeap = -1
+
+  private static emptySamples(): FrameSamples {
+    return { frameIntervals: [], updateTimes: [], renderTimes: [], heapDrops: [], firstFrameAt: -1 }
+  }
+
+  // 清空已采集的帧数据（首帧时间保留）
+  reset(): void {
+    const firstFrameAt = this.samples.firstFrameAt
+    this.samples = FrameTiming.emptySamples()
+    this.samples.firstFrameAt = firstFrameAt
+    this.lastTimestamp = -1
+    this.lastHeap = -1
+  }
+
+  begin(): number {
+    return this.enabled ? performance.now() : 0
+  }
+
+  endUpdate(start: number): void {
+    if (this.enabled) this.samples.updateTimes.push(performance.now() - start)
+  }
+
+  endRender(start: number): void {
+    if (this.enabled) this.samples.renderTimes.push(performance.now() - start)
+  }
+
+  firstFrame(): void {
+    if (this.enabled && this.samples.firstFrameAt < 0) {
+      this.samples.firstFrameAt = performance.now()
+    }
+  }
+
+  // 每帧结束时调用一次，参数为 rAF 时间戳
+  frame(timestamp: number): void {
+    if (!this.enabled) return
+
+    if (this.lastTimestamp >= 0) {
+      this.samples.frameIntervals.push(timestamp - this.lastTimestamp)
+    }
+    this.lastTimestamp = timestamp
+
+    // Chrome 的 performance.memory（非标准）：使用量下降说明发生了一次 GC
+    const memory = (performance as Performance & { memory?: HeapInfo }).memory
+    if (memory) {
+      if (this.lastHeap >= 0 && memory.usedJSHeapSize < this.lastHeap) {
+        this.samples.heapDrops.push(this.lastHeap - memory.usedJSHeapSize)
+      }
+      this.lastHeap = memory.usedJSHeapSize
+    }
+  }
+}
+
+export const frameTiming = new FrameTiming()
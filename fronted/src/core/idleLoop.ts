@@ -0,0 +1,110 @@
+// 省电帧循环：画面静止（待机、游戏结束且没有新事件）或页面隐藏时不再请求 rAF，
+// 直到输入、可见性变化等外部事件调用 wake。
+//
+// 节省的 CPU 时间按“休眠时长 / 帧间隔 × 静止帧耗时”估算：静止帧耗时取进入休眠前那一帧的实测值
+// （状态查询 + 整屏重绘）的滑动平均，帧间隔取醒着时 rAF 时间戳之差的滑动平均（高刷新率屏幕上更大）。
+// 页面隐藏期间浏览器本来就不调度 rAF，这段时间不计入节省
+
+export interface IdleLoopStats {
+  sleeps: number // 进入休眠的次数（不含页面隐藏）
+  sleptMs: number // 累计休眠时长
+  skippedFrames: number // 休眠期间本来要跑的帧数（估算）
+  savedCpuMs: number // 估算节省的主线程 CPU 时间
+  idleFrameCostMs: number // 静止帧的平均耗时
+  frameIntervalMs: number // 平均帧间隔
+}
+
+const SMOOTHING = 0.1 // 滑动平均的权重
+const REPORT_THRESHOLD_MS = 1000 // 休眠超过这么久才在控制台报告
+
+class IdleLoop {
+  stats: IdleLoopStats = {
+    sleeps: 0,
+    sleptMs: 0,
+    skippedFrames: 0,
+    savedCpuMs: 0,
+    idleFrameCostMs: 0,
+    frameIntervalMs: 1000 / 60,
+  }
+
+  private callback: FrameRequestCallback | null = null
+  private frameId = 0
+  private sleepingSince = -1
+  private countSleep = false // 本次休眠是否计入节省（页面隐藏时不计）
+  private lastTimestamp = -1
+
+  isSleeping(): boolean {
+    return this.sleepingSince >= 0
+  }
+
+  start(callback: FrameRequestCallback): void {
+    this.callback = callback
+    this.frameId = requestAnimationFrame(callback)
+  }
+
+  stop(): void {
+    cancelAnimationFrame(this.frameId)
+    this.frameId = 0
+    this.callback = null
+    this.sleepingSince = -1
+  }
+
+  // 每帧末尾调用一次：canSleep 为 true 时不再请求下一帧。
+  // frameCostMs 为本帧耗时，休眠前那一帧就是一帧静止画面的代价
+  endFrame(timestamp: number, frameCostMs: number, canSleep: boolean): void {
+    if (!this.callback) return
+
+    if (this.lastTimestamp >= 0) {
+      const interval = timestamp - this.lastTimestamp
+      // 休眠、卡顿后的第一帧间隔不代表刷新率
+      if (interval > 0 && interval < 100) {
+        this.stats.frameIntervalMs += (interval - this.stats.frameIntervalMs) * SMOOTHING
+      }
+    }
+    this.lastTimestamp = timestamp
+
+    if (!canSleep) {
+      this.frameId = requestAnimationFrame(this.callback)
+      return
+    }
+
+    const cost = this.stats.idleFrameCostMs
+    this.stats.idleFrameCostMs = cost === 0 ? frameCostMs : cost + (frameCostMs - cost) * SMOOTHING
+    this.sleep(true)
+  }
+
+  // 页面隐藏时立即停下（不等下一帧），sleep(false) 不计入节省
+  sleep(counted: boolean): void {
+    if (!this.callback || this.isSleeping()) return
+    cancelAnimationFrame(this.frameId)
+    this.frameId = 0
+    this.sleepingSince = performance.now()
+    this.countSleep = counted
+    if (counted) this.stats.sleeps++
+  }
+
+  // 有可能改变画面的事情发生时调用；醒着时什么也不做
+  wake(): void {
+    if (!this.callback || !this.isSleeping()) return
+
+    const slept = performance.now() - this.sleepingSince
+    this.sleepingSince = -1
+    this.lastTimestamp = -1
+    if (this.countSleep) {
+      const skipped = slept / this.stats.frameIntervalMs
+      this.stats.sleptMs += slept
+      this.stats.skippedFrames += skipped
+      this.stats.savedCpuMs += skipped * this.stats.idleFrameCostMs
+      if (slept >= REPORT_THRESHOLD_MS) {
+        console.log(
+          `省电: 休眠 ${(slept / 1000).toFixed(1)}s，跳过约 ${Math.round(skipped)} 帧，` +
+            `节省约 ${(skipped * this.stats.idleFrameCostMs).toFixed(1)}ms CPU` +
+            `（累计 ${(this.stats.savedCpuMs / 1000).toFixed(2)}s）`,
+        )
+      }
+    }
+    this.frameId = requestAnimationFrame(this.callback)
+  }
+}
+
+export const idleLoop = new IdleLoop()
@@ -1,16 +1,13 @@
 import { defineStore } from 'pinia'
+import { EngineEventType, type EngineEvent } from '../wasm/gameBridge'
 
-interface EngineState {
-  score?: {
-    score: number
-    highScore: number
-  }
-  gameSpeed?: number
-  gameState?: 'IDLE' | 'PLAYING' | 'GAME_OVER'
-}
+type GameStatus = 'IDLE' | 'PLAYING' | 'GAME_OVER'
+
+// 内核状态编码（0:IDLE, 1:PLAYING, 2:GAME_OVER, 3:PAUSED），PAUSED 在界面上按 PLAYING 处理
+const ENGINE_STATES: GameStatus[] = ['IDLE', 'PLAYING', 'GAME_OVER', 'PLAYING']
 
 interface GameStoreState {
-  gameState: 'IDLE' | 'PLAYING' | 'GAME_OVER'
+  gameState: GameStatus
   score: number
   highScore: number
   newRecord: boolean
@@ -27,31 +24,33 @@ export const useGameStore = defineStore('game', {
   }),
 
   actions: {
-    startGame() {
-      this.gameState = 'PLAYING'
-      this.score = 0
-      this.newRecord = false
-    },
-
-    endGame() {
-      this.gameState = 'GAME_OVER'
-    },
-
-    resetGame() {
-      this.gameState = 'IDLE'
-      this.score = 0
-    },
-
     setHighScore(score: number) {
       this.highScore = score
     },
 
-    updateFromEngine(engineState: EngineState) {
-      if (engineState) {
-        this.score = engineState.score?.score || 0
-        this.highScore = engineState.score?.highScore || 0
-        this.gameSpeed = engineState.gameSpeed || 0
-        this.gameState = engineState.gameState || 'IDLE'
+    // 只在内核产生事件时调用，画面上每帧变化的数据（分数等）直接从内核读取
+    applyEngineEvent(event: EngineEvent) {
+      switch (event.type) {
+        case EngineEventType.STATE_CHANGE:
+          this.gameState = ENGINE_STATES[event.a] ?? 'IDLE'
+          if (this.gameState === 'PLAYING') {
+            this.score = 0
+            this.newRecord = false
+          }
+          break
+        case EngineEventType.SCORE_MILESTONE:
+          this.score = event.a
+          break
+        case EngineEventType.NEW_RECORD:
+          this.newRecord = true
+          this.highScore = event.a
+          break
+        case EngineEventType.COLLISION:
+          this.score = event.b
+          break
+        case EngineEventType.SPEED_CHANGE:
+          this.gameSpeed = event.a
+          break
       }
     },
   },
@@ -1,23 +1,53 @@
 // WASM游戏桥接层 - 严格对应C++内核接口
 
+import { RENDER_COMMAND_STRIDE, type ObstacleKind } from '../core/constants'
+import { loadStoredScores } from './scoreStore'
+
 // ============ 类型定义 ============
 // Emscripten模块接口定义
 interface EmscriptenModule {
   HEAPF32: {
     buffer: ArrayBuffer
   }
+  HEAP32: {
+    buffer: ArrayBuffer
+  }
   _malloc(size: number): number
   _free(ptr: number): void
   _game_init(): void
   _game_start(): void // 新增
   _game_update(currentTime: number): void
   _game_jump(): number
+  _game_duck(held: number): void
   _game_restart(): void
   _game_get_state_array(): number
   _game_is_playing(): number
   _game_is_game_over(): number
   _game_get_score(): number
   _game_get_high_score(): number
+  _game_get_render_list(): number
+  _game_get_render_list_count(): number
+  _game_set_schedule_policy(policy: number): void
+  _game_set_step_budget(maxStepsPerFrame: number, budgetMs: number): void
+  _game_set_hidden(hidden: number): void
+  _game_get_simulated_ticks(): number
+  _game_get_dropped_ticks(): number
+  _game_get_budget_exceeded_ticks(): number
+  _game_set_seed(seed: number): void
+  _game_score_store_ingest(mode: number, score: number): void
+  _game_set_leaderboard_mode(mode: number): void
+  _game_get_leaderboard(mode: number): number
+  _game_get_leaderboard_count(mode: number): number
+  _game_get_score_percentile(mode: number, score: number): number
+  _game_set_autoplay(enabled: number): void
+  _game_get_event_ring(): number
+  _game_get_memory_stats(): number
+  _game_versus_start(seed: number): void
+  _game_versus_stop(): void
+  _game_versus_take_packet(): number
+  _game_versus_packet_buffer(): number
+  _game_versus_push_packet(): number
+  _game_versus_get_state(): number
   getValue(ptr: number, type: string): number
   setValue(ptr: number, value: number, type: string): void
 }
@@ -57,10 +87,85 @@ export interface ParsedGameState {
     y: number
     width: number
     height: number
-    type: 'small' | 'big'
+    kind: ObstacleKind
   }>
 }
 
+// 帧调度策略（与 C++ FrameScheduler::Policy 同步）
+export enum SchedulePolicy {
+  PAUSE_ON_HIDDEN = 0,
+  FAST_FORWARD = 1,
+  DROP = 2,
+}
+
+// 内核事件类型（与 C++ EventQueue.hpp 中的 EngineEventType 同步）
+export enum EngineEventType {
+  STATE_CHANGE = 1, // a: 新状态, b: 旧状态（0:IDLE, 1:PLAYING, 2:GAME_OVER, 3:PAUSED）
+  SCORE_MILESTONE = 2, // a: 当前分数
+  NEW_RECORD = 3, // a: 新的最高分
+  JUMP = 4, // a: 1 表示自动游玩触发
+  COLLISION = 5, // a: 障碍物种类（ObstacleKind）, b: 最终分数
+  SPEED_CHANGE = 6, // a: 新速度
+}
+
+export interface EngineEvent {
+  type: EngineEventType
+  a: number
+  b: number
+  tick: number
+}
+
+// 内存占用统计（与 C++ MemoryStats.hpp 同步），单位为字节
+export interface MemoryStats {
+  heapHighWater: number
+  liveBytes: number
+  liveAllocations: number
+  totalAllocations: number
+  stateBufferBytes: number
+  linearMemoryBytes: number
+  heapTop: number
+}
+
+// 对战结果（与 C++ VersusOutcome 同步）
+export enum VersusOutcome {
+  PENDING = 0,
+  WIN = 1,
+  LOSE = 2,
+  DRAW = 3,
+}
+
+// 每个输入包最多携带的输入数（与 C++ VERSUS_PACKET_INPUTS 同步）
+export const VERSUS_PACKET_INPUTS = 16
+const VERSUS_STATE_SIZE = 19
+
+// 对战状态（布局见 GameBridge.hpp 的 game_versus_get_state）
+export interface VersusState {
+  active: boolean
+  outcome: VersusOutcome
+  remoteTick: number
+  remoteConfirmedTick: number
+  remoteScore: number
+  remoteGameState: number // 0:IDLE, 1:PLAYING, 2:GAME_OVER
+  remoteDino: {
+    x: number
+    y: number
+    width: number
+    height: number
+    sprite: { x: number; y: number; w: number; h: number }
+  }
+  rollbacks: number
+  maxRollbackDepth: number
+  stalledFrames: number
+  lastRollbackMs: number
+  maxRollbackMs: number
+}
+
+export interface SchedulerStats {
+  simulatedTicks: number
+  droppedTicks: number
+  budgetExceededTicks: number
+}
+
 // ============ 游戏桥接类 ============
 class GameBridge {
   private module: EmscriptenModule | null = null
@@ -156,6 +261,12 @@ class GameBridge {
     this.module._game_init()
     console.log('游戏引擎初始化完成')
 
+    // 从 IndexedDB 回填本地排行榜
+    const scores = await loadStoredScores()
+    for (const entry of scores) {
+      this.module._game_score_store_ingest(entry.mode, entry.score)
+    }
+
     this.isInitialized = true
     console.log('WASM模块初始化成功')
   }
@@ -178,6 +289,12 @@ class GameBridge {
     return this.module._game_jump() === 1
   }
 
+  // 下蹲键按下/松开
+  duck(held: boolean): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_duck(held ? 1 : 0)
+  }
+
   // 重新开始
   restart(): void {
     if (!this.isInitialized || !this.module) return
@@ -274,9 +391,8 @@ class GameBridge {
       const y = stateArray[index++]
       const width = stateArray[index++]
       const height = stateArray[index++]
-      const typeValue = stateArray[index++]
-      // C++ 中 small 对应 1.0f，big 对应 0.0f，因此这里映射要与之保持一致
-      const type = typeValue > 0.5 ? 'small' : 'big'
+      // 障碍物种类编号（原型表下标）
+      const kind = Math.round(stateArray[index++]) as ObstacleKind
 
       // 防护：确保数值有效，避免 NaN/Infinity 导致渲染异常
       const ox = Number.isFinite(x) ? x : 0
@@ -289,7 +405,7 @@ class GameBridge {
         y: oy,
         width: ow,
         height: oh,
-        type,
+        kind,
       })
     }
 
@@ -303,6 +419,200 @@ class GameBridge {
     }
   }
 
+  // 获取内核生成的绘制列表（直接映射 WASM 内存，不复制）
+  // 返回的视图只在下一次调用 update 之前有效
+  getRenderList(): Float32Array | null {
+    if (!this.isInitialized || !this.module) return null
+
+    const ptr = this.module._game_get_render_list()
+    const count = this.module._game_get_render_list_count()
+    if (ptr === 0 || count <= 0) return null
+
+    // HEAPF32.buffer 在内存增长后会变化，因此每次都重新取
+    return new Float32Array(this.module.HEAPF32.buffer, ptr, count * RENDER_COMMAND_STRIDE)
+  }
+
+  // 读取内核写入事件环形缓冲的全部新事件（布局见 EventQueue.hpp），返回事件数量。
+  // 内核只写 head，这里只写 tail，不需要加锁
+  drainEvents(handler: (event: EngineEvent) => void): number {
+    if (!this.isInitialized || !this.module) return 0
+
+    const ring = this.module._game_get_event_ring()
+    if (ring === 0) return 0
+
+    const heap = new Int32Array(this.module.HEAP32.buffer)
+    const base = ring >> 2
+    const head = heap[base] >>> 0
+    let tail = heap[base + 1] >>> 0
+    const capacity = heap[base + 2]
+    if (head === tail) return 0
+
+    let count = 0
+    while (tail !== head) {
+      const slot = base + 4 + (tail & (capacity - 1)) * 4
+      handler({ type: heap[slot], a: heap[slot + 1], b: heap[slot + 2], tick: heap[slot + 3] })
+      tail = (tail + 1) >>> 0
+      count++
+    }
+    heap[base + 1] = tail | 0
+    return count
+  }
+
+  // 固定随机种子（相同种子生成相同的障碍序列，用于回放与基准）
+  setSeed(seed: number): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_set_seed(seed >>> 0)
+  }
+
+  // 设置卡顿后的追赶策略
+  setSchedulePolicy(policy: SchedulePolicy): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_set_schedule_policy(policy)
+  }
+
+  // 设置每帧最多追赶的步数与 CPU 时间预算（毫秒）
+  setStepBudget(maxStepsPerFrame: number, budgetMs: number): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_set_step_budget(maxStepsPerFrame, budgetMs)
+  }
+
+  // 通知内核页面是否可见
+  setHidden(hidden: boolean): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_set_hidden(hidden ? 1 : 0)
+  }
+
+  // 获取调度统计
+  getSchedulerStats(): SchedulerStats | null {
+    if (!this.isInitialized || !this.module) return null
+    return {
+      simulatedTicks: this.module._game_get_simulated_ticks(),
+      droppedTicks: this.module._game_get_dropped_ticks(),
+      budgetExceededTicks: this.module._game_get_budget_exceeded_ticks(),
+    }
+  }
+
+  // 自动游玩（待机演示）：内核按跳跃轨迹表自动起跳
+  setAutoplay(enabled: boolean): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_set_autoplay(enabled ? 1 : 0)
+  }
+
+  // 切换排行榜模式（最高分随之切换）
+  setLeaderboardMode(mode: number): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_set_leaderboard_mode(mode)
+  }
+
+  // 获取某个模式的排行榜（降序，复制一份，不受后续写入影响）
+  getLeaderboard(mode: number): number[] {
+    if (!this.isInitialized || !this.module) return []
+
+    const ptr = this.module._game_get_leaderboard(mode)
+    const count = this.module._game_get_leaderboard_count(mode)
+    if (ptr === 0 || count <= 0) return []
+
+    return Array.from(new Int32Array(this.module.HEAP32.buffer, ptr, count))
+  }
+
+  // 低于 score 的历史成绩所占百分比（0~100）
+  getScorePercentile(mode: number, score: number): number {
+    if (!this.isInitialized || !this.module) return 0
+    return this.module._game_get_score_percentile(mode, score)
+  }
+
+  // 内核内存占用（堆峰值、存活分配、共享缓冲、线性内存大小）
+  getMemoryStats(): MemoryStats | null {
+    if (!this.isInitialized || !this.module) return null
+
+    const ptr = this.module._game_get_memory_stats()
+    if (ptr === 0) return null
+
+    const fields = new Int32Array(this.module.HEAP32.buffer, ptr, 7)
+    return {
+      heapHighWater: fields[0] >>> 0,
+      liveBytes: fields[1] >>> 0,
+      liveAllocations: fields[2] >>> 0,
+      totalAllocations: fields[3] >>> 0,
+      stateBufferBytes: fields[4] >>> 0,
+      linearMemoryBytes: fields[5] >>> 0,
+      heapTop: fields[6] >>> 0,
+    }
+  }
+
+  // 以给定种子开始双人竞速，之后 update/jump/duck 都经过对战会话；restart 会结束对战
+  versusStart(seed: number): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_versus_start(seed >>> 0)
+  }
+
+  versusStop(): void {
+    if (!this.isInitialized || !this.module) return
+    this.module._game_versus_stop()
+  }
+
+  // 取出本帧待发的输入包（每帧 update 之后调用），截掉未使用的输入后复制出来交给传输层
+  takeVersusPackets(): Uint8Array[] {
+    if (!this.isInitialized || !this.module) return []
+
+    const packets: Uint8Array[] = []
+    for (;;) {
+      const ptr = this.module._game_versus_take_packet()
+      if (ptr === 0) break
+      const count = new Uint32Array(this.module.HEAP32.buffer, ptr, 2)[1]
+      packets.push(new Uint8Array(this.module.HEAP32.buffer, ptr, 8 + count * 4).slice())
+    }
+    return packets
+  }
+
+  // 把对手发来的输入包交给内核；长度与 count 不符或超出上限时丢弃
+  pushVersusPacket(packet: Uint8Array): boolean {
+    if (!this.isInitialized || !this.module) return false
+    if (packet.byteLength < 8 || packet.byteLength % 4 !== 0) return false
+
+    const count = new DataView(packet.buffer, packet.byteOffset, packet.byteLength).getUint32(4, true)
+    if (count > VERSUS_PACKET_INPUTS || packet.byteLength !== 8 + count * 4) return false
+
+    const ptr = this.module._game_versus_packet_buffer()
+    new Uint8Array(this.module.HEAP32.buffer, ptr, packet.byteLength).set(packet)
+    return this.module._game_versus_push_packet() === 1
+  }
+
+  // 对手的状态与回滚统计（从未开始过对战时返回 null）
+  getVersusState(): VersusState | null {
+    if (!this.isInitialized || !this.module) return null
+
+    const ptr = this.module._game_versus_get_state()
+    if (ptr === 0) return null
+
+    const f = new Float32Array(this.module.HEAPF32.buffer, ptr, VERSUS_STATE_SIZE)
+    return {
+      active: f[0] > 0.5,
+      outcome: Math.round(f[1]) as VersusOutcome,
+      remoteTick: f[2],
+      remoteConfirmedTick: f[3],
+      remoteScore: f[4],
+      remoteGameState: f[5],
+      remoteDino: {
+        x: f[6],
+        y: f[7],
+        width: f[8],
+        height: f[9],
+        sprite: { x: f[10], y: f[11], w: f[12], h: f[13] },
+      },
+      rollbacks: f[14],
+      maxRollbackDepth: f[15],
+      stalledFrames: f[16],
+      lastRollbackMs: f[17],
+      maxRollbackMs: f[18],
+    }
+  }
+
+  // WASM 模块是否已初始化完成
+  isReady(): boolean {
+    return this.isInitialized
+  }
+
   // 是否正在游戏中
   isPlaying(): boolean {
     if (!this.isInitialized || !this.module) return false
@@ -0,0 +1,40 @@
+// 本地排行榜的 IndexedDB 存储（与 C++ ScoreStore.cpp 中的 js_score_store_append 使用同一个库）
+// 内核在每局结束时异步追加记录；页面启动时在这里读回所有记录交给内核建立索引
+
+const DB_NAME = 'dino_scores'
+const DB_VERSION = 1
+const STORE_NAME = 'scores'
+
+export interface StoredScore {
+  mode: number
+  score: number
+  timestamp: number
+}
+
+function openDatabase(): Promise<IDBDatabase> {
+  return new Promise((resolve, reject) => {
+    const request = indexedDB.open(DB_NAME, DB_VERSION)
+    request.onupgradeneeded = () => {
+      request.result.createObjectStore(STORE_NAME, { autoIncrement: true })
+    }
+    request.onsuccess = () => resolve(request.result)
+    request.onerror = () => reject(request.error)
+  })
+}
+
+// 读取全部历史分数；不支持 IndexedDB 或读取失败时返回空数组
+export async function loadStoredScores(): Promise<StoredScore[]> {
+  if (typeof indexedDB === 'undefined') return []
+
+  try {
+    const db = await openDatabase()
+    return await new Promise<StoredScore[]>((resolve, reject) => {
+      const request = db.transaction(STORE_NAME, 'readonly').objectStore(STORE_NAME).getAll()
+      request.onsuccess = () => resolve(request.result as StoredScore[])
+      request.onerror = () => reject(request.error)
+    })
+  } catch (error) {
+    console.warn('读取排行榜失败:', error)
+    return []
+  }
+}
@@ -0,0 +1,126 @@
+// 双人竞速的输入传输（内核一侧见 InputTransport.hpp）
+//
+// 输入包是内核 InputPacket 的字节（小端，已截掉未使用的输入），由 gameBridge 取出/放回；
+// 传输层只负责可靠有序地把包送到对手。控制消息用 JSON 文本帧：
+//   客户端 -> 中继 {type:'join'}           请求配对（连接建立后自动发送一次，之后每局再发；
+//                                          排队期间仍与上一局的对手互相转发输入）
+//   中继 -> 客户端 {type:'start', seed}     配对成功，双方以同一种子开局
+//   中继 -> 客户端 {type:'peer-left'}       对手断开
+// 中继服务见 scripts/versus-relay.mjs
+
+export interface VersusTransport {
+  onStart: ((seed: number) => void) | null
+  onPacket: ((packet: Uint8Array) => void) | null
+  onPeerLeft: (() => void) | null
+  send(packet: Uint8Array): void
+  requestMatch(): void
+  close(): void
+}
+
+// WebSocket 传输：TCP 保证可靠有序，正好满足回滚对输入顺序的要求
+export class WebSocketTransport implements VersusTransport {
+  onStart: ((seed: number) => void) | null = null
+  onPacket: ((packet: Uint8Array) => void) | null = null
+  onPeerLeft: (() => void) | null = null
+
+  private socket: WebSocket
+
+  constructor(url: string) {
+    this.socket = new WebSocket(url)
+    this.socket.binaryType = 'arraybuffer'
+    this.socket.onopen = () => this.requestMatch()
+    this.socket.onmessage = (event: MessageEvent) => {
+      if (typeof event.data === 'string') {
+        this.handleControl(event.data)
+      } else {
+        this.onPacket?.(new Uint8Array(event.data as ArrayBuffer))
+      }
+    }
+    this.socket.onclose = () => this.onPeerLeft?.()
+  }
+
+  send(packet: Uint8Array): void {
+    if (this.socket.readyState === WebSocket.OPEN) {
+      this.socket.send(packet)
+    }
+  }
+
+  requestMatch(): void {
+    if (this.socket.readyState === WebSocket.OPEN) {
+      this.socket.send(JSON.stringify({ type: 'join' }))
+    }
+  }
+
+  close(): void {
+    this.socket.onclose = null
+    this.socket.close()
+  }
+
+  private handleControl(text: string): void {
+    let message: { type?: string; seed?: number }
+    try {
+      message = JSON.parse(text)
+    } catch {
+      console.warn('无法解析的对战控制消息:', text)
+      return
+    }
+    if (message.type === 'start' && typeof message.seed === 'number') {
+      this.onStart?.(message.seed >>> 0)
+    } else if (message.type === 'peer-left') {
+      this.onPeerLeft?.()
+    }
+  }
+}
+
+// 本机回环：把自己的输入延迟 latencyMs 后作为“对手”的输入送回，对手即自己的影子。
+// 不需要服务器，用于在浏览器里验证预测与回滚（延迟越大回滚越深）
+export class LoopbackTransport implements VersusTransport {
+  onStart: ((seed: number) => void) | null = null
+  onPacket: ((packet: Uint8Array) => void) | null = null
+  onPeerLeft: (() => void) | null = null
+
+  private latencyMs: number
+  private timers = new Set<ReturnType<typeof setTimeout>>()
+
+  constructor(latencyMs = 80) {
+    this.latencyMs = latencyMs
+    this.requestMatch()
+  }
+
+  send(packet: Uint8Array): void {
+    // setTimeout 同样延迟的回调按调用顺序执行，包保持有序
+    const timer = setTimeout(() => {
+      this.timers.delete(timer)
+      this.onPacket?.(packet)
+    }, this.latencyMs)
+    this.timers.add(timer)
+  }
+
+  requestMatch(): void {
+    this.clearPending()
+    const seed = (Math.random() * 0x100000000) >>> 0
+    // 等调用方挂好回调后再开局
+    queueMicrotask(() => this.onStart?.(seed))
+  }
+
+  close(): void {
+    this.clearPending()
+  }
+
+  private clearPending(): void {
+    for (const timer of this.timers) {
+      clearTimeout(timer)
+    }
+    this.timers.clear()
+  }
+}
+
+// URL 参数 ?versus=loopback 或 ?versus=ws://host:port 开启对战，否则返回 null
+export function createVersusTransport(search: string): VersusTransport | null {
+  const target = new URLSearchParams(search).get('versus')
+  if (!target) return null
+  if (target === 'loopback') return new LoopbackTransport()
+  if (target.startsWith('ws://') || target.startsWith('wss://')) return new WebSocketTransport(target)
+  console.warn('无法识别的对战地址:', target)
+  return null
+}
@@ -27,12 +27,12 @@ export default defineConfig({
   build: {
     outDir: 'dist',
     assetsDir: 'assets',
-    // 确保 game.js, game.wasm, sprite.png 不被重命名
+    // 确保 game.js, game.wasm, atlas.png 不被重命名
     rollupOptions: {
       output: {
         assetFileNames: (assetInfo) => {
           const name = assetInfo.name || ''
-          if (['game.js', 'game.wasm', 'sprite.png'].includes(name)) {
+          if (['game.js', 'game.wasm', 'atlas.png'].includes(name)) {
             return '[name].[ext]' // 保持原名
           }
           return 'assets/[name]-[hash].[ext]'
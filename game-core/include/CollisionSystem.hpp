@@ -1,22 +1,34 @@
 #ifndef COLLISIONSYSTEM_HPP
 #define COLLISIONSYSTEM_HPP
 
+#include "FixedPoint.hpp"
+
+// 碰撞相关的计算全部使用模拟数值类型 Scalar，定点模式下碰撞判定与回退逐位确定
 struct Rect {
-    float x, y;
-    float width, height;
+    Scalar x, y;
+    Scalar width, height;
 };
 
 struct CollisionResult {
     bool collided;
-    const char* obstacleType;
+    int obstacleKind; // ObstacleKind，没有碰撞时为 -1
+    Scalar timeOfImpact; // 本次更新内的碰撞时刻，0 为更新开始，1 为更新结束
 };
 
 class CollisionSystem {
 public:
     CollisionResult checkCollision(const class Dino& dino, const class ObstacleManager& obstacleManager);
+
+    // 连续碰撞检测：dinoStart 为本次更新前恐龙的包围盒，obstacleShift 为本次更新中
+    // 障碍物向左移动的距离。大步长（例如卡顿后追帧）时也不会穿透障碍物
+    CollisionResult checkSweptCollision(const Rect& dinoStart, const class Dino& dino,
+                                        const class ObstacleManager& obstacleManager,
+                                        Scalar obstacleShift);
     
 private:
     bool rectIntersect(const Rect& rect1, const Rect& rect2);
+    // 移动矩形 moving 以位移 (vx, vy) 扫过静止矩形 target，返回是否相交及最早相交时刻
+    bool sweptIntersect(const Rect& moving, Scalar vx, Scalar vy, const Rect& target, Scalar& toi);
 };
 
 #endif // COLLISIONSYSTEM_HPP
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef COURSEGENERATOR_HPP
+#define COURSEGENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FixedPoint.hpp"
+#include "Random.hpp"
+
+// 赛道中的一组障碍物（紧凑布局，便于批量生成与拷贝）
+struct CourseEntry {
+    Distance worldX;     // 该组障碍物出现在屏幕右边缘时的世界距离（像素）
+    uint8_t type;        // ObstacleKind，即原型表下标
+    uint8_t count;       // 同组障碍物数量
+    uint8_t variantMask; // 第 i 位为 1 表示第 i 个障碍物使用第二个精灵变体
+    uint8_t reserved;
+};
+
+// 预先按世界距离分块生成赛道：随机数与各种间距规则只在生成时执行，
+// 每帧只需沿游标滚动。相同种子得到相同赛道，与帧率和帧时间无关
+class CourseGenerator {
+public:
+    CourseGenerator();
+
+    void setSeed(uint32_t seed);
+    void reset(); // 从世界距离 0 重新开始（沿用当前随机数状态）
+
+    // 下一组尚未生成到场景中的障碍物，必要时生成下一块赛道
+    const CourseEntry& peek();
+    void advance();
+
+    // 批量生成到指定世界距离（测试、离线分析用），结果追加到 getEntries()
+    void generateUntil(Distance distance);
+    const std::vector<CourseEntry>& getEntries() const;
+
+    // 在给定世界距离处的游戏速度（与 ScoreManager 的加速规则一致）
+    float speedAtDistance(Distance distance) const;
+
+private:
+    void generateChunk();
+    void appendUntil(Distance distance);
+    Scalar nextGap(float gameSpeed);
+
+    Random random;
+    std::vector<CourseEntry> entries; // 当前块，已消费的部分在生成下一块时丢弃
+    size_t cursor;
+    Distance nextWorldX;
+
+    // 各速度档位开始时的世界距离，speedLevelStart[k] 对应速度 INITIAL_GAME_SPEED + k
+    std::vector<Distance> speedLevelStart;
+};
+
+#endif // COURSEGENERATOR_HPP
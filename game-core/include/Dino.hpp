@@ -2,19 +2,24 @@
 #define DINO_HPP
 
 #include "constants.hpp"
+#include "FixedPoint.hpp"
 
 class Dino {
 public:
     Dino();
     void reset();
     void update(float deltaTime);
-    bool jump();
+    bool jump(); // 下蹲时不能起跳
+    void setDucking(bool held); // 按住下蹲键：在地面上立即下蹲，空中按住则落地后下蹲
     void die();
+    void moveTo(Scalar newY); // 直接设置竖直位置（碰撞回退时使用）
     
     struct State {
         float x, y;
+        float yVelocity;
         int width, height;
         bool isJumping;
+        bool isDucking;
         bool isDead;
         struct Sprite {
             int x, y, w, h;
@@ -22,25 +27,30 @@ public:
     };
     
     State getState() const;
+    Scalar getY() const; // 模拟精度的竖直位置（State::y 只用于渲染）
     
     struct BoundingBox {
-        float x, y;
-        float width, height;
+        Scalar x, y;
+        Scalar width, height;
     };
     
     BoundingBox getBoundingBox() const;
 
 private:
     void updateSprite();
+    void applyPosture(); // 按下蹲键状态切换站立/下蹲的尺寸，保持脚踩在地面上
     
     float x;
-    float y;
-    float yVelocity;
+    Scalar y;
+    Scalar yVelocity;
     int width;
     int height;
     bool isJumping;
+    bool isDucking;
+    bool duckHeld;
     bool isDead;
     bool isOnGround;
+    int animCounter; // 跑步动画计数，作为成员保证回放确定性
     DinoConstants::Sprite currentSprite;
 };
 
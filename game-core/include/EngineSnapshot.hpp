@@ -0,0 +1,22 @@
+#ifndef ENGINESNAPSHOT_HPP
+#define ENGINESNAPSHOT_HPP
+
+#include "Dino.hpp"
+#include "FixedPoint.hpp"
+#include "GameState.hpp"
+#include "ObstacleManager.hpp"
+#include "ScoreManager.hpp"
+
+// 引擎的完整模拟状态（GameEngine::saveSnapshot / loadSnapshot）。
+// 组件都是值类型，直接按值保存；障碍物与赛道块只有十几项，一次保存约几百字节
+struct EngineSnapshot {
+    Dino dino;
+    ObstacleManager obstacles; // 含赛道生成器（随机数状态与未消费的赛道块）
+    ScoreManager score;
+    GameState::State state;
+    Scalar gameSpeed;
+    Scalar groundOffset;
+    int tickCount;
+};
+
+#endif // ENGINESNAPSHOT_HPP
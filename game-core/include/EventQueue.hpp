@@ -0,0 +1,59 @@
+#ifndef EVENTQUEUE_HPP
+#define EVENTQUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// 内核事件类型（与前端 gameBridge.ts 中的 EngineEventType 同步）
+enum EngineEventType {
+    EVENT_STATE_CHANGE = 1,    // a: 新状态, b: 旧状态（0:IDLE, 1:PLAYING, 2:GAME_OVER, 3:PAUSED）
+    EVENT_SCORE_MILESTONE = 2, // a: 当前分数（每 SCORE_MILESTONE_INTERVAL 分一次）
+    EVENT_NEW_RECORD = 3,      // a: 新的最高分
+    EVENT_JUMP = 4,            // a: 1 表示自动游玩触发
+    EVENT_COLLISION = 5,       // a: 障碍物种类（ObstacleKind，见 ObstacleManager.hpp）, b: 最终分数
+    EVENT_SPEED_CHANGE = 6     // a: 新速度（每帧像素，取整）
+};
+
+// 一条事件，16 字节
+struct EngineEvent {
+    int32_t type;
+    int32_t a;
+    int32_t b;
+    int32_t tick; // 产生事件时本局的步数
+};
+
+constexpr uint32_t EVENT_RING_CAPACITY = 256; // 必须是 2 的幂
+
+static_assert((EVENT_RING_CAPACITY & (EVENT_RING_CAPACITY - 1)) == 0, "容量必须是 2 的幂");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "需要无锁的 32 位原子变量");
+
+// 单生产者（内核）单消费者（前端）的无锁环形缓冲，整块位于 WASM 线性内存中，
+// 前端按固定偏移直接读写：
+//   0: head（内核写入的下一个位置）  4: tail（前端读到的位置）
+//   8: capacity  12: dropped  16: events[capacity]
+// head / tail 单调递增，取模得到槽位。缓冲已满时丢弃新事件并计数，内核永远不会等待前端
+struct EventRing {
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    uint32_t capacity;
+    uint32_t dropped;
+    EngineEvent events[EVENT_RING_CAPACITY];
+};
+
+class EventQueue {
+public:
+    EventQueue();
+
+    // 生产者：写入一条事件，缓冲已满时返回 false
+    bool push(int32_t type, int32_t a, int32_t b, int32_t tick);
+
+    // 消费者（原生工具使用；浏览器中由前端直接读取内存）
+    bool pop(EngineEvent& event);
+
+    EventRing* getRing();
+
+private:
+    EventRing ring;
+};
+
+#endif // EVENTQUEUE_HPP
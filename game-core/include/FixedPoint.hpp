@@ -0,0 +1,95 @@
+#ifndef FIXEDPOINT_HPP
+#define FIXEDPOINT_HPP
+
+#include <cmath>
+#include <cstdint>
+
+// 定点数（16 位小数）。Raw 为 int32_t 时即 Q16.16，用于位置、速度等每帧状态；
+// Raw 为 int64_t 时用于会持续增长的世界距离。
+// 加减乘除全部是整数运算，浏览器 WASM 与原生 x86 服务器上结果逐位一致。
+template <typename Raw>
+class BasicFixed {
+public:
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr Raw ONE = static_cast<Raw>(1) << FRACTION_BITS;
+
+    BasicFixed() : raw(0) {}
+
+    // 允许从 float 隐式转换，使模拟代码在浮点与定点模式下写法一致
+    BasicFixed(float value)
+        : raw(static_cast<Raw>(static_cast<double>(value) * ONE + (value >= 0.0f ? 0.5 : -0.5))) {}
+
+    // 不同位宽之间转换（小数位相同，只改变整数部分范围）
+    template <typename OtherRaw>
+    explicit BasicFixed(BasicFixed<OtherRaw> other) : raw(static_cast<Raw>(other.getRaw())) {}
+
+    static BasicFixed fromRaw(Raw value) {
+        BasicFixed result;
+        result.raw = value;
+        return result;
+    }
+
+    Raw getRaw() const { return raw; }
+    float toFloat() const { return static_cast<float>(static_cast<double>(raw) / ONE); }
+
+    BasicFixed& operator+=(BasicFixed other) { raw += other.raw; return *this; }
+    BasicFixed& operator-=(BasicFixed other) { raw -= other.raw; return *this; }
+    BasicFixed& operator*=(BasicFixed other) { *this = *this * other; return *this; }
+
+    friend BasicFixed operator+(BasicFixed a, BasicFixed b) { return fromRaw(a.raw + b.raw); }
+    friend BasicFixed operator-(BasicFixed a, BasicFixed b) { return fromRaw(a.raw - b.raw); }
+    friend BasicFixed operator-(BasicFixed a) { return fromRaw(-a.raw); }
+    friend BasicFixed operator*(BasicFixed a, BasicFixed b) {
+        return fromRaw(static_cast<Raw>((static_cast<int64_t>(a.raw) * b.raw) >> FRACTION_BITS));
+    }
+    friend BasicFixed operator/(BasicFixed a, BasicFixed b) {
+        return fromRaw(static_cast<Raw>((static_cast<int64_t>(a.raw) << FRACTION_BITS) / b.raw));
+    }
+
+    friend bool operator<(BasicFixed a, BasicFixed b) { return a.raw < b.raw; }
+    friend bool operator>(BasicFixed a, BasicFixed b) { return a.raw > b.raw; }
+    friend bool operator<=(BasicFixed a, BasicFixed b) { return a.raw <= b.raw; }
+    friend bool operator>=(BasicFixed a, BasicFixed b) { return a.raw >= b.raw; }
+    friend bool operator==(BasicFixed a, BasicFixed b) { return a.raw == b.raw; }
+    friend bool operator!=(BasicFixed a, BasicFixed b) { return a.raw != b.raw; }
+
+private:
+    Raw raw;
+};
+
+typedef BasicFixed<int32_t> Fixed;
+typedef BasicFixed<int64_t> FixedDistance;
+
+// 模拟使用的数值类型：默认使用 float；定义 DINO_FIXED_POINT 时切换为定点数，
+// 用于在原生服务器上逐位校验浏览器录制的回放
+#ifdef DINO_FIXED_POINT
+typedef Fixed Scalar;
+typedef FixedDistance Distance;
+#else
+typedef float Scalar;
+typedef float Distance;
+#endif
+
+inline float toFloat(float value) {
+    return value;
+}
+
+template <typename Raw>
+inline float toFloat(BasicFixed<Raw> value) {
+    return value.toFloat();
+}
+
+// 将 value 折回 [0, period) 区间（地面滚动偏移等）
+inline float wrap(float value, float period) {
+    float result = std::fmod(value, period);
+    return result < 0.0f ? result + period : result;
+}
+
+template <typename Raw>
+inline BasicFixed<Raw> wrap(BasicFixed<Raw> value, BasicFixed<Raw> period) {
+    Raw result = value.getRaw() % period.getRaw();
+    if (result < 0) result += period.getRaw();
+    return BasicFixed<Raw>::fromRaw(result);
+}
+
+#endif // FIXEDPOINT_HPP
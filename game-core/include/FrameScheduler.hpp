@@ -0,0 +1,55 @@
+#ifndef FRAMESCHEDULER_HPP
+#define FRAMESCHEDULER_HPP
+
+#include <chrono>
+
+// 将浏览器的帧时间切分为固定步长的模拟步，并在卡顿（切后台、GC）后
+// 按策略追赶或丢弃错过的时间，每帧的追赶量受步数和 CPU 时间预算限制
+class FrameScheduler {
+public:
+    enum class Policy {
+        PAUSE_ON_HIDDEN, // 页面隐藏时冻结时钟；可见时与 FAST_FORWARD 相同
+        FAST_FORWARD,    // 补跑所有错过的时间，超出预算的部分顺延到后续帧
+        DROP             // 超出单帧预算的时间直接丢弃（旧的 50ms 截断行为）
+    };
+
+    struct Stats {
+        int simulatedTicks;      // 实际执行的模拟步数
+        int droppedTicks;        // 被丢弃的步数
+        int budgetExceededTicks; // 因超出预算而被顺延或丢弃的步数
+    };
+
+    FrameScheduler();
+
+    void resetClock(); // 下一帧视为第一帧，不补跑之前的时间
+    void setPolicy(Policy policy);
+    Policy getPolicy() const;
+    void setBudget(int maxStepsPerFrame, float budgetMs);
+    void setHidden(bool hidden);
+
+    // 每帧调用一次：根据当前时间（毫秒）累积待模拟的时间
+    void beginFrame(float currentTime);
+    // 循环调用，返回 true 表示应再执行一个固定步
+    bool nextStep();
+    // 本帧结束：处理未在预算内完成的积压
+    void endFrame();
+
+    Stats getStats() const;
+
+private:
+    Policy policy;
+    int maxStepsPerFrame;
+    float budgetMs;
+    bool hidden;
+
+    float lastTime;
+    bool hasLastTime;
+    float accumulator;
+    int stepsThisFrame;
+    int pendingCounted; // 已计入 budgetExceededTicks 的积压步数
+    std::chrono::steady_clock::time_point frameStart;
+
+    Stats stats;
+};
+
+#endif // FRAMESCHEDULER_HPP
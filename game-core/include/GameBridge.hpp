@@ -9,6 +9,7 @@ extern "C" {
 void game_init();
 void game_update(float currentTime);
 int game_jump();
+void game_duck(int held); // 1 按下下蹲键，0 松开
 void game_restart();
 void game_start();
 float* game_get_state_array();
@@ -17,6 +18,51 @@ int game_is_game_over();
 int game_get_score();
 int game_get_high_score();
 
+// 精灵绘制列表，每条命令 RENDER_COMMAND_STRIDE 个 float
+float* game_get_render_list();
+int game_get_render_list_count();
+
+// 帧调度：policy 0=隐藏时暂停 1=快进追赶 2=丢弃
+void game_set_schedule_policy(int policy);
+void game_set_step_budget(int maxStepsPerFrame, float budgetMs);
+void game_set_hidden(int hidden);
+int game_get_simulated_ticks();
+int game_get_dropped_ticks();
+int game_get_budget_exceeded_ticks();
+
+// 固定随机种子（回放、基准测试）
+void game_set_seed(unsigned int seed);
+
+// 本地排行榜：mode 为排行榜模式，ingest 用于启动时从 IndexedDB 回填
+void game_score_store_ingest(int mode, int score);
+void game_set_leaderboard_mode(int mode);
+int* game_get_leaderboard(int mode);
+int game_get_leaderboard_count(int mode);
+float game_get_score_percentile(int mode, int score);
+
+// 自动游玩（待机演示）：1 开启，0 关闭
+void game_set_autoplay(int enabled);
+
+// 内核事件环形缓冲（布局见 EventQueue.hpp），前端每帧读取一次
+void* game_get_event_ring();
+
+// 内存占用统计（布局见 MemoryStats.hpp）：堆峰值、存活分配、共享缓冲大小、线性内存大小
+unsigned int* game_get_memory_stats();
+
+// 双人竞速（见 VersusSession.hpp）：start 以给定种子开局，之后 update/jump/duck 都经过对战会话。
+// 每帧 update 后用 take_packet 取出待发的包（InputPacket 布局，没有时返回 0）交给 WebSocket；
+// 收到的包写入 packet_buffer 后调用 push_packet（count 超出上限时丢弃并返回 0）
+void game_versus_start(unsigned int seed);
+void game_versus_stop();
+void* game_versus_take_packet();
+void* game_versus_packet_buffer();
+int game_versus_push_packet();
+// 对战状态，VERSUS_STATE_SIZE 个 float：
+// [0]进行中 [1]结果(0未定 1胜 2负 3平) [2]对手步数 [3]对手已确认步数 [4]对手分数 [5]对手状态
+// [6..9]对手恐龙 x,y,w,h [10..13]对手恐龙精灵 x,y,w,h [14]回滚次数 [15]最大回滚步数 [16]等待帧数
+// [17]最近一次回滚耗时(ms) [18]最大回滚耗时(ms)
+float* game_versus_get_state();
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,20 +5,26 @@
 #include <emscripten.h>
 #endif
 
-#include <string>
-#include <functional>
+#include <vector>
+#include <cstdint>
+
+#include "FixedPoint.hpp"
+#include "GameState.hpp"
 
 class Dino;
 class ObstacleManager;
 class CollisionSystem;
 class ScoreManager;
-class GameState;
+class RenderList;
+class FrameScheduler;
+class ScoreStore;
+class EventQueue;
+struct EngineSnapshot;
 
 // 前向声明 JavaScript 函数，但不在这里定义
 #ifdef __EMSCRIPTEN__
 extern "C" {
-    void js_save_high_score(int score);
-    int js_load_high_score();
+    int js_load_high_score(); // 旧版 localStorage 中的最高分，仅用于迁移
 }
 #endif
 
@@ -31,19 +37,52 @@ public:
     bool reset();
     void update(float currentTime);
     bool jump();
-    void* gameOver(); // 返回游戏结束信息
+    void duck(bool held); // 下蹲键按下/松开
+
+    // 无界面（headless）驱动：固定随机种子，并逐步推进一个固定步长，
+    // 不经过帧调度，也不生成绘制列表
+    void setSeed(uint32_t seed);
+    void tick();
+    int getTickCount() const; // 本局已模拟的步数
+
+    // 自动游玩（待机演示、长时间稳定性测试）：每步查跳跃轨迹表决定起跳或下蹲
+    void setAutoplay(bool enabled);
+    bool isAutoplay() const;
+
+    // 回滚（对战模式）：保存/恢复全部模拟状态（见 EngineSnapshot.hpp）。
+    // 不包括帧调度器、事件队列与排行榜，它们不影响模拟结果
+    void saveSnapshot(EngineSnapshot& snapshot) const;
+    void loadSnapshot(const EngineSnapshot& snapshot);
+    // 关闭后游戏结束时不写排行榜（对战中的对手引擎会在预测中途“死亡”再被回滚）
+    void setScoreRecording(bool enabled);
+    // 游戏结束信息，每个引擎一份（多个引擎可以在不同线程上同时运行）
+    struct GameOverInfo {
+        bool newRecord;
+        int finalScore;
+        int highScore;
+    };
+    const GameOverInfo* gameOver(); // 返回游戏结束信息，已经结束时返回 nullptr
     
-    // 保存和加载最高分
-    void saveHighScore();
+    // 将本局分数记录到排行榜；最高分从排行榜加载
+    void recordScore();
     void loadHighScore();
+
+    // 排行榜：原生环境需要先打开存储目录，浏览器由前端从 IndexedDB 回填
+    bool openScoreStore(const char* directory);
+    ScoreStore& getScoreStore();
+    void ingestScore(int mode, int score);
+    void setLeaderboardMode(int mode);
+    int getLeaderboardMode() const;
     
     float* getFlattenedState();
     
     struct RenderState {
         struct DinoState {
             float x, y;
+            float yVelocity;
             int width, height;
             bool isJumping;
+            bool isDucking;
             bool isDead;
             struct Sprite {
                 int x, y, w, h;
@@ -64,6 +103,19 @@ public:
     };
     
     RenderState getStateForRender();
+
+    // 本帧的精灵绘制列表（见 RenderList.hpp）
+    const RenderList& getRenderList() const;
+
+    // 帧调度器：追赶策略、每帧预算与统计
+    FrameScheduler& getFrameScheduler();
+
+    // 内核事件队列（状态变化、分数里程碑、新纪录、跳跃、碰撞、速度变化），
+    // 前端每帧读取一次，只在有事件时更新界面状态
+    EventQueue& getEventQueue();
+
+    // 与前端共享的缓冲总大小：状态数组、绘制列表、事件环（字节）
+    int getStateBufferBytes() const;
     
     // 获取当前分数和最高分
     int getScore() const;
@@ -71,15 +123,31 @@ public:
     void setHighScore(int highScore);
 
 private:
+    static void handleStateChange(void* userData, GameState::State newState, GameState::State oldState);
+    void step(float deltaMs); // 推进一个模拟步
+    void autoplayStep();
+    void buildRenderList();
+
     Dino* dino;
     ObstacleManager* obstacleManager;
     CollisionSystem* collisionSystem;
     ScoreManager* scoreManager;
     GameState* gameState;
+    RenderList* renderList;
+    FrameScheduler* frameScheduler;
+    ScoreStore* scoreStore;
+    EventQueue* eventQueue;
+    int leaderboardMode;
     
-    float gameSpeed;
-    float lastTime;
-    float groundOffset;
+    Scalar gameSpeed;
+    Scalar groundOffset;
+    int tickCount;
+    bool autoplay;
+    bool scoreRecording;
+    GameOverInfo gameOverInfo;
+
+    float* flattenedState; // getFlattenedState 的缓冲，每个引擎一份（对战时同时存在两个引擎）
+    int flattenedStateSize;
 };
 
 #endif // GAMEENGINE_HPP
\ No newline at end of file
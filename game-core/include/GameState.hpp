@@ -1,8 +1,6 @@
 #ifndef GAMESTATE_HPP
 #define GAMESTATE_HPP
 
-#include <string>
-#include <functional>
 
 class GameState {
 public:
@@ -15,11 +13,17 @@ public:
     bool isPlaying() const;
     bool isGameOver() const;
     bool canTransitionTo(State newState) const;
+    State get() const;
+    // 回滚时直接恢复到快照中的状态，不检查转换规则也不触发回调
+    void restore(State state);
     
-    // 回调函数，对应JavaScript的onStateChange
-    std::function<void(State, State)> onStateChange;
+    // 状态变化回调，对应JavaScript的onStateChange（普通函数指针 + 用户数据，不依赖 std::function）
+    typedef void (*StateChangeCallback)(void* userData, State newState, State oldState);
+    void setOnStateChange(StateChangeCallback callback, void* userData);
 
 private:
+    StateChangeCallback onStateChange;
+    void* onStateChangeUserData;
     State state;
     State lastState;
 };
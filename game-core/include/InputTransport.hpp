@@ -0,0 +1,66 @@
+#ifndef INPUTTRANSPORT_HPP
+#define INPUTTRANSPORT_HPP
+
+#include <cstdint>
+#include <deque>
+
+constexpr int VERSUS_PACKET_INPUTS = 16; // 每个包最多携带的输入数
+
+// 对战中交换的输入包（小端，前端按同样的布局读写，发送时截掉未使用的 inputs）。
+// confirmedTick：发送方 tick 小于该值的输入已经全部发出，接收方可以确定地模拟到这一步
+struct InputPacket {
+    uint32_t confirmedTick;
+    uint32_t count;
+    uint32_t inputs[VERSUS_PACKET_INPUTS]; // ReplayInput.hpp 的编码，按 tick 升序
+};
+
+// 输入传输接口，要求可靠且有序（WebSocket、进程内回环都满足）
+class InputTransport {
+public:
+    virtual ~InputTransport() {}
+    virtual void send(const InputPacket& packet) = 0;
+    virtual bool receive(InputPacket& packet) = 0; // 没有已到达的包时返回 false
+};
+
+// 进程内回环：connect 连接两个端点，对方每帧调用一次 advance，
+// 发出的包在对方 advance latency 次之后才能收到，用于原生测试与测量
+class LoopbackTransport : public InputTransport {
+public:
+    LoopbackTransport();
+
+    static void connect(LoopbackTransport& a, LoopbackTransport& b);
+    void setLatency(int frames); // 之后发出的包的延迟（帧），变小时也不会超过之前的包
+    void advance();
+
+    void send(const InputPacket& packet) override;
+    bool receive(InputPacket& packet) override;
+
+private:
+    struct Pending {
+        InputPacket packet;
+        int deliverAt;
+    };
+
+    LoopbackTransport* peer;
+    std::deque<Pending> inbox;
+    int latency;
+    int frame;
+};
+
+// 队列传输（浏览器）：内核只读写队列，前端每帧取出待发的包交给 WebSocket，
+// 收到的包再放回内核（见 game_versus_* 桥接函数）
+class QueueTransport : public InputTransport {
+public:
+    void send(const InputPacket& packet) override;
+    bool receive(InputPacket& packet) override;
+
+    bool takeOutbound(InputPacket& packet);
+    void pushInbound(const InputPacket& packet);
+    void clear();
+
+private:
+    std::deque<InputPacket> outbox;
+    std::deque<InputPacket> inbox;
+};
+
+#endif // INPUTTRANSPORT_HPP
@@ -0,0 +1,74 @@
+#ifndef JUMPARC_HPP
+#define JUMPARC_HPP
+
+#include <vector>
+
+#include "constants.hpp"
+
+// 跳跃轨迹表：启动时用真实的 Dino::update 按固定步长模拟一次完整跳跃，
+// 记录每个离地高度（恐龙碰撞盒底部高于地面时的高度）可以越过的时间区间。
+// 之后“现在起跳能否越过某个障碍物”只需查表和几次乘除，O(1)。
+//
+// 时间以模拟步为单位（可为小数，步与步之间按线性插值，与扫掠碰撞检测一致），
+// 距离为世界像素：步数 × 速度（每步像素）。
+class JumpArc {
+public:
+    // 全局唯一的表（首次使用时构建，只读，可跨线程共享）
+    static const JumpArc& get();
+
+    // 从起跳到落地所需的步数，落地当步即可再次起跳
+    int getAirTicks() const;
+
+    // 某种障碍物（ObstacleKind）碰撞盒顶部高于恐龙碰撞盒底部（站在地面时）的高度，
+    // 即越过该障碍物所需的离地高度
+    float clearanceFor(int kind) const;
+    // 某种障碍物碰撞盒底部高于恐龙碰撞盒顶部（站立或下蹲时）的高度，
+    // 不小于 0 表示保持该姿势即可从下方通过
+    float headroomFor(int kind, bool ducking) const;
+    // count 个该种类、首尾相接的障碍物的碰撞盒总宽度
+    static float groupSpan(int kind, int count);
+
+    // 离地高度不低于 clearance 的时间区间 [enter, exit]，跳不到该高度时返回 false
+    bool clearWindow(float clearance, float& enter, float& exit) const;
+
+    // 现在起跳能否越过一组障碍物：
+    // gap 为障碍物组碰撞盒左边缘到恐龙碰撞盒右边缘的水平距离，
+    // span 为障碍物组碰撞盒的总宽度，speed 为每步滚动的像素
+    bool canClear(float gap, float span, float clearance, float speed) const;
+
+    // 自动游玩：能越过且下一步再跳就来不及时起跳（最晚起跳，落地最早）
+    bool shouldJump(float gap, float span, float clearance, float speed) const;
+
+    // 越过一组障碍物（按最晚时机起跳）后，下一组障碍物的前缘至少要落后多少世界距离
+    // 才仍能起跳越过（next 为下一组所需的离地高度）。任一组跳不到所需高度时返回 false，distance 不变
+    bool minFollowDistance(float clearance, float nextClearance, float speed, float& distance) const;
+
+    // 按给定速度，这组障碍物是否存在可以越过的起跳时机
+    bool isClearable(float span, float clearance, float speed) const;
+
+    // 恐龙碰撞盒的宽度与右边缘（站立时）
+    float getDinoBoxWidth() const;
+    float getDinoBoxRight() const;
+    // 下蹲时碰撞盒的右边缘（下蹲时身体向前伸）
+    float getDuckBoxRight() const;
+
+private:
+    JumpArc();
+
+    struct Window {
+        float enter;
+        float exit;
+    };
+
+    std::vector<float> rise;      // 第 k 步结束时碰撞盒底部的离地高度（k = 0 为起跳前）
+    std::vector<Window> windows;  // 按整数离地高度索引
+    int airTicks;
+    float dinoBoxWidth;
+    float dinoBoxRight;
+    float duckBoxRight;
+    // 按种类预先算好的越过高度与头顶余量
+    float clearances[ObstacleConstants::KIND_COUNT];
+    float headrooms[ObstacleConstants::KIND_COUNT][2];
+};
+
+#endif // JUMPARC_HPP
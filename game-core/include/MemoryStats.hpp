@@ -0,0 +1,21 @@
+#ifndef MEMORYSTATS_HPP
+#define MEMORYSTATS_HPP
+
+#include <cstdint>
+
+// 内存占用统计（game_get_memory_stats 返回的结构，前端按 7 个 uint32 读取）。
+// 内核中所有通过 operator new 的分配都会被计数，用于验证嵌入页面时的内存预算
+struct MemoryStats {
+    uint32_t heapHighWater;     // 存活分配字节数的峰值
+    uint32_t liveBytes;         // 当前存活的分配字节数
+    uint32_t liveAllocations;   // 当前存活的分配次数
+    uint32_t totalAllocations;  // 累计分配次数
+    uint32_t stateBufferBytes;  // 与前端共享的缓冲：状态数组、绘制列表、事件环
+    uint32_t linearMemoryBytes; // WASM 线性内存总大小（原生为 0）
+    uint32_t heapTop;           // 分配器的堆顶地址 sbrk(0)，即实际使用的堆上限（原生为 0）
+};
+
+// 填写分配计数与线性内存信息（stateBufferBytes 由调用方填写）
+void readMemoryStats(MemoryStats& stats);
+
+#endif // MEMORYSTATS_HPP
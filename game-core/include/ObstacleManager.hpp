@@ -2,38 +2,59 @@
 #define OBSTACLEMANAGER_HPP
 
 #include <vector>
-#include <string>
+#include <cstdint>
+
+#include "CourseGenerator.hpp"
+#include "FixedPoint.hpp"
+
+// 障碍物种类（与 CourseEntry::type 的编码及 ObstacleConstants::ARCHETYPES 的顺序一致）
+enum ObstacleKind {
+    OBSTACLE_SMALL = 0,
+    OBSTACLE_BIG = 1,
+    OBSTACLE_BIRD_LOW = 2,
+    OBSTACLE_BIRD_MID = 3,
+    OBSTACLE_BIRD_HIGH = 4
+};
 
 struct Obstacle {
-    std::string type; // "small" or "big"
-    float x, y;
+    uint8_t kind; // ObstacleKind
+    Scalar x;
+    float y;
     int width, height;
     int spriteX, spriteY;
     
     struct BoundingBox {
-        float x, y;
-        float width, height;
+        Scalar x, y;
+        Scalar width, height;
     };
     
-    BoundingBox boundingBox() const;
+    BoundingBox boundingBox() const; // 按原型表的内缩量计算
 };
 
 class ObstacleManager {
 public:
     ObstacleManager();
+    void setSeed(uint32_t seed); // 固定随机种子，相同种子生成相同的障碍序列
     void reset();
-    void update(float deltaTime, float gameSpeed);
+    void update(float deltaTime, Scalar gameSpeed);
+    void shift(Scalar dx); // 所有障碍物整体右移 dx（碰撞回退时使用）
     
+    // 障碍物始终按 x 升序排列：新障碍物总在最右侧生成，且所有障碍物以相同速度左移
     const std::vector<Obstacle>& getObstacles() const;
 
+    // 返回可能与 [left, right) 水平区间重叠的障碍物下标范围 [first, last)
+    void queryRange(Scalar left, Scalar right, size_t& first, size_t& last) const;
+
+    // 已滚动的世界距离（像素）
+    Distance getDistance() const;
+
 private:
-    void spawnObstacle();
-    float getRandomSpawnTime();
-    float computeNextSpawnTime(float gameSpeed);
+    void spawnEntry(const CourseEntry& entry);
     
     std::vector<Obstacle> obstacles;
-    float spawnTimer;
-    float nextSpawnTime;
+    CourseGenerator course;
+    int maxObstacleWidth; // 用于区间查询时向左扩展搜索范围
+    Distance distance;
 };
 
 #endif // OBSTACLEMANAGER_HPP
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+
+// 可设定种子的伪随机数生成器（xorshift32）
+// 不依赖 std::rand 的平台实现，相同种子在浏览器与原生环境下产生相同序列
+class Random {
+public:
+    explicit Random(uint32_t seed = 1);
+
+    void seed(uint32_t seed);
+    uint32_t next();
+    int nextInt(int bound);   // [0, bound)
+    float nextFloat();        // [0, 1]
+
+private:
+    uint32_t state;
+};
+
+#endif // RANDOM_HPP
@@ -0,0 +1,34 @@
+#ifndef RENDERLIST_HPP
+#define RENDERLIST_HPP
+
+#include <vector>
+
+// 渲染层级，数值小的先绘制
+enum RenderLayer {
+    LAYER_GROUND = 0,
+    LAYER_OBSTACLE = 1,
+    LAYER_DINO = 2
+};
+
+// 每条绘制命令在扁平数组中占用的 float 数量：
+// [spriteX, spriteY, spriteW, spriteH, destX, destY, destW, destH, layer]
+constexpr int RENDER_COMMAND_STRIDE = 9;
+
+// 引擎每帧生成的精灵绘制列表，缓冲区在帧之间复用，
+// 前端可以直接按 RENDER_COMMAND_STRIDE 遍历 HEAPF32
+class RenderList {
+public:
+    void clear();
+    void push(float sx, float sy, float sw, float sh,
+              float dx, float dy, float dw, float dh,
+              RenderLayer layer);
+
+    const float* data() const;
+    int count() const;
+    int capacityBytes() const; // 已分配的缓冲大小（字节）
+
+private:
+    std::vector<float> commands;
+};
+
+#endif // RENDERLIST_HPP
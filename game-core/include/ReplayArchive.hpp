@@ -0,0 +1,128 @@
+#ifndef REPLAYARCHIVE_HPP
+#define REPLAYARCHIVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ReplayInput.hpp"
+
+// 回放存档（仅原生构建）：服务端校验玩家提交的对局。
+//
+// 一个存档目录包含两个文件：
+//   replays.dat  只追加的回放记录：ReplayRecordHeader 后接 inputCount 个输入（uint32，见 ReplayInput.hpp）
+//   replays.idx  定长索引：每条记录一个 ReplayIndexEntry（数据偏移 + 元数据）
+// 两个文件都整体 mmap，按序号随机访问或顺序遍历都不需要拷贝或解码；只按元数据筛选时
+// 不会触及数据文件的页面。写入时先写数据再写索引，索引缺失或落后时从数据文件重建。
+
+constexpr uint32_t REPLAY_DATA_MAGIC = 0x50525244;   // "DRRP"
+constexpr uint32_t REPLAY_INDEX_MAGIC = 0x58525244;  // "DRRX"
+constexpr uint32_t REPLAY_RECORD_MAGIC = 0x43455252; // "RREC"
+constexpr uint32_t REPLAY_VERSION = 1;
+constexpr uint32_t REPLAY_MAX_TICKS = 1u << 22;      // 声称的步数上限（约 19 小时），防止超长记录拖住校验
+constexpr uint32_t REPLAY_FLUSH_BATCH = 4096;        // 写入端累计多少条记录后写盘
+
+struct ReplayFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t reserved;
+};
+
+// 一局的元数据：客户端提交的种子、声称的结果与提交信息
+struct ReplayMeta {
+    uint32_t seed;
+    uint32_t playerId;
+    uint32_t submittedAt;  // 秒
+    int32_t claimedScore;
+    uint32_t claimedTicks; // 游戏结束（碰撞）时的步数
+    uint32_t inputCount;
+};
+
+struct ReplayRecordHeader {
+    uint32_t magic;
+    uint32_t reserved;
+    ReplayMeta meta;
+};
+
+struct ReplayIndexEntry {
+    uint64_t offset; // 记录头在 replays.dat 中的偏移
+    ReplayMeta meta;
+};
+
+static_assert(sizeof(ReplayIndexEntry) == 32, "索引项需要保持定长");
+
+// 追加写入端：单个进程独占写入。记录先缓存在内存中，每 REPLAY_FLUSH_BATCH 条或 flush 时
+// 依次写出数据与索引并 fsync
+class ReplayArchiveWriter {
+public:
+    ReplayArchiveWriter();
+    ~ReplayArchiveWriter();
+
+    // 打开（或创建）目录下的存档；截掉上次崩溃留下的不完整尾部，补齐落后的索引
+    bool open(const char* directory);
+    void close();
+
+    // inputs 需按 tick 升序
+    void append(const ReplayMeta& meta, const uint32_t* inputs);
+    bool flush();
+
+    uint64_t getRecordCount() const;
+
+private:
+    bool recoverIndex();
+
+    int dataFd;
+    int indexFd;
+    uint64_t dataBytes;   // 已写出（含缓冲中）的数据文件长度
+    uint64_t recordCount; // 已写出（含缓冲中）的记录数
+    bool failed;
+    std::vector<unsigned char> pendingData;
+    std::vector<ReplayIndexEntry> pendingIndex;
+};
+
+// 只读访问：mmap 数据与索引，输入数组直接指向映射内存
+class ReplayArchive {
+public:
+    ReplayArchive();
+    ~ReplayArchive();
+
+    bool open(const char* directory);
+    void close();
+
+    size_t count() const;
+    const ReplayIndexEntry& entry(size_t index) const;
+    const uint32_t* inputs(size_t index) const;
+
+private:
+    const unsigned char* data;
+    size_t dataSize;
+    const unsigned char* indexData;
+    size_t indexSize;
+    const ReplayIndexEntry* entries;
+    size_t entryCount;
+};
+
+// 校验结果
+enum ReplayStatus {
+    REPLAY_OK = 0,
+    REPLAY_MALFORMED,    // 输入未按 tick 排序、超出声称的步数或动作无效，或声称的步数超出上限
+    REPLAY_ENDED_EARLY,  // 在声称的步数之前就撞上了障碍物
+    REPLAY_NOT_ENDED,    // 到达声称的步数时仍在游戏中
+    REPLAY_SCORE_MISMATCH
+};
+
+struct ReplayVerdict {
+    ReplayStatus status;
+    int ticks; // 实际模拟的步数
+    int score; // 实际分数
+};
+
+const char* replayStatusName(ReplayStatus status);
+
+class GameEngine;
+
+// 在 headless 引擎上按种子和输入重新模拟一局，与声称的结果比对。
+// 引擎可以复用（每次调用都会重置），调用方需关闭自动游玩
+ReplayVerdict verifyReplay(GameEngine& engine, const ReplayMeta& meta, const uint32_t* inputs);
+
+#endif // REPLAYARCHIVE_HPP
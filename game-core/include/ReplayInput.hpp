@@ -0,0 +1,26 @@
+#ifndef REPLAYINPUT_HPP
+#define REPLAYINPUT_HPP
+
+#include <cstdint>
+
+// 输入事件编码（回放存档与对战模式共用）：(tick << 2) | action，tick 为施加输入时本局已模拟的步数
+// （即在第 tick + 1 步之前调用 GameEngine::jump / duck）
+enum ReplayAction {
+    REPLAY_JUMP = 0,
+    REPLAY_DUCK_PRESS = 1,
+    REPLAY_DUCK_RELEASE = 2
+};
+
+inline uint32_t encodeReplayInput(uint32_t tick, ReplayAction action) {
+    return (tick << 2) | static_cast<uint32_t>(action);
+}
+
+inline uint32_t replayInputTick(uint32_t input) {
+    return input >> 2;
+}
+
+inline ReplayAction replayInputAction(uint32_t input) {
+    return static_cast<ReplayAction>(input & 3);
+}
+
+#endif // REPLAYINPUT_HPP
@@ -0,0 +1,78 @@
+#ifndef SCORESTORE_HPP
+#define SCORESTORE_HPP
+
+#include <cstdint>
+#include <vector>
+
+// 排行榜参数
+constexpr int LEADERBOARD_MODES = 4;           // 支持的游戏模式数量
+constexpr int LEADERBOARD_TOP_K = 100;         // 每个模式保留的最高分数量
+constexpr int SCORE_HISTOGRAM_BUCKETS = 4096;  // 分数直方图桶数（用于百分位查询）
+constexpr int SCORE_BUCKET_WIDTH = 4;          // 每桶覆盖的分数范围，更高的分数计入最后一桶
+constexpr int SCORE_FLUSH_BATCH = 64;          // 原生环境下累计多少条记录后写盘并 fsync
+
+// 追加日志中的一条记录
+struct ScoreRecord {
+    uint32_t mode;
+    int32_t score;
+    uint32_t timestamp; // 秒
+    uint32_t reserved;
+};
+
+// 排行榜索引：原生环境直接映射到文件，浏览器中位于堆内存。
+// 只包含定长数组，可以整体 mmap，不需要反序列化
+struct LeaderboardIndex {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t indexedRecords; // 已 fsync 到日志并计入索引的记录数，与日志长度不一致时从日志重建
+    uint64_t unflushedRecords; // 已计入索引但还没 fsync 到日志的记录数，打开时不为 0 说明落盘前崩溃，从日志重建
+
+    struct Mode {
+        uint32_t count;
+        int32_t topCount;
+        int32_t top[LEADERBOARD_TOP_K];              // 降序
+        uint32_t histogram[SCORE_HISTOGRAM_BUCKETS];
+    } modes[LEADERBOARD_MODES];
+};
+
+// 本地排行榜存储。
+// 原生：追加写入二进制日志（scores.log），排行榜索引映射到 scores.idx，批量 fsync；
+// 浏览器：索引在内存中，每条记录异步写入 IndexedDB，启动时由前端读回并 ingest。
+// 写入不会阻塞帧循环（浏览器不再同步写 localStorage）
+class ScoreStore {
+public:
+    ScoreStore();
+    ~ScoreStore();
+
+    // 打开（或创建）目录下的日志与索引；浏览器环境下直接返回 true
+    bool open(const char* directory);
+    void close();
+
+    // 记录一局的最终分数：更新索引并持久化
+    void record(int mode, int score);
+    // 只更新索引，不持久化（浏览器启动时从 IndexedDB 恢复）
+    void ingest(int mode, int score);
+    // 原生：写出缓冲的记录并 fsync
+    void flush();
+
+    int best(int mode) const;
+    int topCount(int mode) const;
+    const int32_t* top(int mode) const;
+    uint32_t count(int mode) const;
+    // 低于 score 的记录所占百分比（0~100）
+    float percentile(int mode, int score) const;
+
+private:
+    void resetIndex();
+    void applyToIndex(int mode, int score);
+    bool rebuildFromLog();
+    static int clampMode(int mode);
+
+    LeaderboardIndex* index;
+    bool mapped;
+    int logFd;
+    int indexFd;
+    std::vector<ScoreRecord> pending;
+};
+
+#endif // SCORESTORE_HPP
@@ -0,0 +1,32 @@
+// 由 fronted/scripts/pack-atlas.mjs 根据 fronted/assets/atlas.json 生成，请勿手动修改
+#ifndef SPRITEATLAS_HPP
+#define SPRITEATLAS_HPP
+
+// 图集中的一个精灵；多帧精灵的各帧在同一行，第 i 帧位于 x + i * stride
+struct AtlasSprite {
+    int x, y, w, h;
+    int stride;
+};
+
+constexpr int ATLAS_WIDTH = 964;
+constexpr int ATLAS_HEIGHT = 164;
+
+constexpr AtlasSprite ATLAS_DINO_RUN_1 = {104, 2, 88, 94, 0};
+constexpr AtlasSprite ATLAS_DINO_RUN_2 = {194, 2, 88, 94, 0};
+constexpr AtlasSprite ATLAS_DINO_JUMP = {284, 2, 88, 94, 0};
+constexpr AtlasSprite ATLAS_DINO_DEAD = {374, 2, 88, 94, 0};
+constexpr AtlasSprite ATLAS_DINO_DUCK_1 = {724, 2, 118, 60, 0};
+constexpr AtlasSprite ATLAS_DINO_DUCK_2 = {844, 2, 118, 60, 0};
+constexpr AtlasSprite ATLAS_CACTUS_SMALL = {652, 2, 34, 70, 36};
+constexpr AtlasSprite ATLAS_CACTUS_BIG = {2, 2, 49, 100, 51};
+constexpr AtlasSprite ATLAS_BIRD = {464, 2, 92, 80, 94};
+
+// GROUND 条带按顺序切成的段，依次首尾相接即为完整条带
+constexpr int ATLAS_GROUND_SLICE_COUNT = 3;
+constexpr AtlasSprite ATLAS_GROUND_SLICES[ATLAS_GROUND_SLICE_COUNT] = {
+    {2, 104, 960, 18, 960},
+    {2, 124, 960, 18, 960},
+    {2, 144, 484, 18, 484},
+};
+
+#endif // SPRITEATLAS_HPP
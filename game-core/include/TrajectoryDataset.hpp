@@ -0,0 +1,154 @@
+#ifndef TRAJECTORYDATASET_HPP
+#define TRAJECTORYDATASET_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 逐步轨迹数据集（仅原生构建）：headless 模拟时每一步记录一行，用于分析与训练机器人。
+//
+// 文件布局：FileHeader 后接若干块（chunk）。每块以 ChunkHeader 开头，之后按列存放
+// 该块的所有行，每列连续且按 8 字节对齐，因此 mmap 后可以直接按列访问，不需要解码。
+// 数据不做压缩（压缩后无法零拷贝），需要压缩时交给文件系统。
+
+// 列定义，顺序即块内的存放顺序
+enum TrajectoryColumn {
+    TRAJ_EPISODE,        // uint32  局编号（写入端自行分配）
+    TRAJ_TICK,           // uint32  局内步数
+    TRAJ_DINO_Y,         // float
+    TRAJ_DINO_VELOCITY,  // float   竖直速度
+    TRAJ_JUMPING,        // uint8   是否在空中
+    TRAJ_DUCKING,        // uint8   是否在下蹲（自动游玩的下蹲动作）
+    TRAJ_OBSTACLE_DX,    // float   最近的前方障碍物左边缘到恐龙右边缘的距离（没有时为 -1）
+    TRAJ_OBSTACLE_WIDTH, // float
+    TRAJ_OBSTACLE_HEIGHT,// float
+    TRAJ_OBSTACLE_KIND,  // uint8   ObstacleKind（没有时为 255）；三种鸟的精灵尺寸相同，只能靠种类或高度区分
+    TRAJ_OBSTACLE_BOTTOM,// float   障碍物下边缘的 y（没有时为 0），与恐龙的 y 同一坐标系
+    TRAJ_NEXT_DX,        // float   第二个前方障碍物的距离（没有时为 -1）
+    TRAJ_GAME_SPEED,     // float
+    TRAJ_SCORE,          // int32
+    TRAJ_DONE,           // uint8   本步后游戏结束
+    TRAJ_COLUMN_COUNT
+};
+
+// 每列元素的字节数
+extern const uint32_t TRAJECTORY_COLUMN_SIZES[TRAJ_COLUMN_COUNT];
+
+constexpr uint32_t TRAJECTORY_FILE_MAGIC = 0x4A525444;  // "DTRJ"
+constexpr uint32_t TRAJECTORY_CHUNK_MAGIC = 0x4B484354; // "TCHK"
+constexpr uint32_t TRAJECTORY_VERSION = 2;              // 2: 增加下蹲、障碍物种类与下边缘列
+constexpr uint32_t TRAJECTORY_CHUNK_ROWS = 65536;        // 每块行数上限（约 2.4MB）
+
+struct TrajectoryFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t columnCount;
+    uint32_t chunkRows;
+};
+
+struct TrajectoryChunkHeader {
+    uint32_t magic;
+    uint32_t rows;
+    uint64_t bytes; // 含块头在内的块大小
+};
+
+// 一行数据（写入端使用）
+struct TrajectoryRow {
+    uint32_t episode;
+    uint32_t tick;
+    float dinoY;
+    float dinoVelocity;
+    uint8_t jumping;
+    uint8_t ducking;
+    float obstacleDx;
+    float obstacleWidth;
+    float obstacleHeight;
+    uint8_t obstacleKind;
+    float obstacleBottom;
+    float nextDx;
+    float gameSpeed;
+    int32_t score;
+    uint8_t done;
+};
+
+class GameEngine;
+
+// 从引擎当前状态（getStateForRender）生成一行
+TrajectoryRow makeTrajectoryRow(GameEngine& engine, uint32_t episode, uint32_t tick);
+
+// 双缓冲写入器：模拟线程写入当前缓冲，写满后交给后台 I/O 线程落盘并切换到另一块缓冲。
+// 只有磁盘持续慢于模拟时 append 才会等待。每个模拟线程使用自己的写入器（各写一个文件）
+class TrajectoryWriter {
+public:
+    TrajectoryWriter();
+    ~TrajectoryWriter();
+
+    bool open(const char* path);
+    void append(const TrajectoryRow& row);
+    // 写出剩余的行并等待 I/O 线程结束；有块写入失败（磁盘写满等）时返回 false
+    bool close();
+
+    // 以下查询可以在 close() 之前随时调用：failed 与 rowsWritten 由 I/O 线程更新，使用原子变量
+    bool hasFailed() const;
+    uint64_t getRowsWritten() const; // 已经写入文件的行数（不含缓冲中和写入失败的行）
+    uint64_t getStallCount() const; // append 等待 I/O 的次数（只由调用 append 的线程更新）
+
+private:
+    struct ChunkBuffer {
+        std::vector<unsigned char> columns[TRAJ_COLUMN_COUNT];
+        uint32_t rows;
+    };
+
+    void submitActive();
+    void ioLoop();
+    bool writeChunk(const ChunkBuffer& buffer);
+
+    int fd;
+    ChunkBuffer buffers[2];
+    int activeBuffer;
+    int pendingBuffer; // 等待 I/O 线程写出的缓冲，-1 表示没有
+    bool stopping;
+    std::atomic<bool> failed;
+    std::atomic<uint64_t> rowsWritten;
+    uint64_t stallCount;
+
+    std::thread ioThread;
+    std::mutex mutex;
+    std::condition_variable wake;
+};
+
+// 只读访问：mmap 整个文件，列数据直接指向映射内存
+class TrajectoryReader {
+public:
+    struct Chunk {
+        uint32_t rows;
+        const unsigned char* columns[TRAJ_COLUMN_COUNT];
+    };
+
+    TrajectoryReader();
+    ~TrajectoryReader();
+
+    bool open(const char* path);
+    void close();
+
+    size_t chunkCount() const;
+    const Chunk& chunk(size_t index) const;
+    uint64_t rowCount() const;
+
+    template <typename T>
+    const T* column(size_t chunkIndex, TrajectoryColumn column) const {
+        return reinterpret_cast<const T*>(chunks[chunkIndex].columns[column]);
+    }
+
+private:
+    const unsigned char* data;
+    size_t size;
+    std::vector<Chunk> chunks;
+    uint64_t rows;
+};
+
+#endif // TRAJECTORYDATASET_HPP
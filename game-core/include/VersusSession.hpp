@@ -0,0 +1,90 @@
+#ifndef VERSUSSESSION_HPP
+#define VERSUSSESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ReplayInput.hpp"
+
+class GameEngine;
+class InputTransport;
+struct EngineSnapshot;
+
+constexpr int VERSUS_MAX_ROLLBACK = 8; // 最多回滚（预测）的步数
+constexpr int VERSUS_STATE_SIZE = 19;  // game_versus_get_state 返回的 float 个数
+
+// 对局结果
+enum VersusOutcome {
+    VERSUS_PENDING = 0,
+    VERSUS_WIN = 1,
+    VERSUS_LOSE = 2,
+    VERSUS_DRAW = 3
+};
+
+// 双人竞速：两只恐龙在同一种子的赛道上各自奔跑，互不干扰，分数高者获胜。
+//
+// 本地玩家照常由 GameEngine::update 按帧推进，输入在按下时记录（tick 为当时的步数）并按帧发给对手。
+// 对手由会话持有的第二个引擎模拟：已确认的步数之内按收到的输入模拟；之后最多预测
+// VERSUS_MAX_ROLLBACK 步（假设没有新输入，下蹲保持按住状态）。预测区间内每步保存快照，
+// 迟到的输入落在已预测的步数上时恢复快照并重新模拟。对手输入迟到超过上限时对手画面停下等待，
+// 本地不受影响
+class VersusSession {
+public:
+    struct Stats {
+        int rollbacks;          // 回滚次数
+        int resimulatedTicks;   // 回滚重新模拟的总步数
+        int maxRollbackDepth;   // 单次回滚的最大步数
+        int stalledFrames;      // 因对手输入迟到超过上限而停下等待的帧数
+        int rejectedInputs;     // 违反协议被丢弃的输入（早于已确认步数或乱序）
+        float lastRollbackMs;   // 最近一次回滚（恢复快照 + 重新模拟）的耗时
+        float maxRollbackMs;
+    };
+
+    VersusSession();
+    ~VersusSession();
+
+    // 双方以相同种子开局。local 为本地玩家的引擎（浏览器中即桥接层的引擎），会被重置并开始；
+    // transport 由调用方持有，会话结束前必须保持有效
+    void start(GameEngine* local, InputTransport* transport, uint32_t seed);
+    void stop();
+    bool isActive() const;
+
+    // 每帧调用一次：推进本地引擎，发送本帧的本地输入，接收对手输入（必要时回滚）并推进对手
+    void update(float currentTime);
+
+    // 本地输入：施加到本地引擎并记录，下一次 update 时发出
+    bool jump();
+    void duck(bool held);
+
+    GameEngine& getRemote();
+    int getRemoteConfirmedTick() const;
+    VersusOutcome getOutcome() const;
+    const Stats& getStats() const;
+
+private:
+    void recordLocalInput(ReplayAction action);
+    void sendInputs();
+    void receiveInputs();
+    void rollbackTo(int tick);
+    bool simulateRemoteTick(); // 对手已经结束时返回 false
+    void advanceRemote(int targetTick);
+    bool isLocalPlaying() const;
+    bool isRemoteFinished() const; // 对手确定已经结束（不是预测中的结束）
+
+    GameEngine* local;
+    GameEngine* remote;
+    InputTransport* transport;
+    EngineSnapshot* snapshots; // 按 tick 取模的环形缓冲，VERSUS_MAX_ROLLBACK + 1 项
+
+    std::vector<uint32_t> outbound;     // 本帧的本地输入
+    int lastSentTick;                   // 上次发出的 confirmedTick
+    std::vector<uint32_t> remoteInputs; // 按 tick 升序
+    size_t remoteCursor;                // 下一个要施加的对手输入
+    int remoteConfirmed;
+
+    Stats stats;
+    bool active;
+};
+
+#endif // VERSUSSESSION_HPP
@@ -1,6 +1,8 @@
 #ifndef CONSTANTS_HPP
 #define CONSTANTS_HPP
 
+#include "SpriteAtlas.hpp" // 精灵在图集中的位置（由 fronted/scripts/pack-atlas.mjs 生成）
+
 // 游戏物理参数
 constexpr float GRAVITY = 1.5f; // 重力（加快下落速度，设为1.5）
 // 跳跃力度、初始速度
@@ -8,31 +10,57 @@ constexpr float JUMP_FORCE = -38.0f; // 跳跃力度（负值向上，设为-38
 constexpr float INITIAL_GAME_SPEED = 13.0f; // 初始速度（设为13）
 constexpr float MAX_GAME_SPEED = 30.0f; // 最大速度，至少为30以满足要求
 
-// 游戏对象尺寸（基于精灵图）
+// 游戏对象尺寸（精灵位置均为图集坐标）
 struct DinoConstants {
     constexpr static int WIDTH = 89;
     constexpr static int HEIGHT = 94;
+    // 下蹲时的尺寸（碰撞盒随之变矮变宽）
+    constexpr static int DUCK_WIDTH = 118;
+    constexpr static int DUCK_HEIGHT = 60;
     
     struct Sprite {
         int x, y, w, h;
     };
     
-    constexpr static Sprite RUN_1 = {1514, 0, 88, 94};
-    constexpr static Sprite RUN_2 = {1602, 0, 88, 94};
-    constexpr static Sprite JUMP = {1338, 0, 88, 94};
-    constexpr static Sprite DEAD = {1788, 0, 88, 94};
+    constexpr static Sprite RUN_1 = {ATLAS_DINO_RUN_1.x, ATLAS_DINO_RUN_1.y, ATLAS_DINO_RUN_1.w, ATLAS_DINO_RUN_1.h};
+    constexpr static Sprite RUN_2 = {ATLAS_DINO_RUN_2.x, ATLAS_DINO_RUN_2.y, ATLAS_DINO_RUN_2.w, ATLAS_DINO_RUN_2.h};
+    constexpr static Sprite JUMP = {ATLAS_DINO_JUMP.x, ATLAS_DINO_JUMP.y, ATLAS_DINO_JUMP.w, ATLAS_DINO_JUMP.h};
+    constexpr static Sprite DEAD = {ATLAS_DINO_DEAD.x, ATLAS_DINO_DEAD.y, ATLAS_DINO_DEAD.w, ATLAS_DINO_DEAD.h};
+    constexpr static Sprite DUCK_1 = {ATLAS_DINO_DUCK_1.x, ATLAS_DINO_DUCK_1.y, ATLAS_DINO_DUCK_1.w, ATLAS_DINO_DUCK_1.h};
+    constexpr static Sprite DUCK_2 = {ATLAS_DINO_DUCK_2.x, ATLAS_DINO_DUCK_2.y, ATLAS_DINO_DUCK_2.w, ATLAS_DINO_DUCK_2.h};
 };
 
+// 障碍物原型表：按种类编号（ObstacleKind）连续存放。生成、碰撞、绘制和序列化都直接按编号查表，
+// 不按种类分支，新增种类只需在表末尾加一行
 struct ObstacleConstants {
-    struct Config {
-        int WIDTH;
-        int HEIGHT;
-        int SPRITE_X;
-        int SPRITE_Y;
+    struct Archetype {
+        AtlasSprite SPRITE; // 图集中的精灵，障碍物尺寸即精灵尺寸；stride 为相邻外观变体 / 动画帧的间距
+        int VARIANTS;      // 生成时随机选择的外观数
+        int FRAMES;        // 动画帧数（1 为静止）
+        int ALTITUDE;      // 底部离地高度（0 为地面障碍物）
+        int SPAWN_WEIGHT;  // 生成权重
+        int MAX_GROUP;     // 同组最多数量
+        int HITBOX_INSET;  // 碰撞盒每边内缩的像素
+        float MIN_SPEED;   // 游戏速度达到该值后才会生成
     };
-    
-    constexpr static Config SMALL = {34, 70, 446, 2};
-    constexpr static Config BIG = {49, 100, 652, 2};
+
+    constexpr static int KIND_COUNT = 5;
+    constexpr static Archetype ARCHETYPES[KIND_COUNT] = {
+        // SPRITE,           VAR, FRM, ALT, WEIGHT, GROUP, INSET, MIN_SPEED
+        {ATLAS_CACTUS_SMALL, 2, 1, 0, 3, 2, 5, 0.0f},    // 小仙人掌
+        {ATLAS_CACTUS_BIG, 2, 1, 0, 3, 2, 5, 0.0f},      // 大仙人掌
+        {ATLAS_BIRD, 1, 2, 20, 1, 1, 10, 15.0f},         // 低空翼龙：只能跳过
+        {ATLAS_BIRD, 1, 2, 50, 1, 1, 10, 15.0f},         // 中空翼龙：下蹲或跳过
+        {ATLAS_BIRD, 1, 2, 100, 1, 1, 10, 15.0f},        // 高空翼龙：站着即可通过，起跳会撞上
+    };
+
+    constexpr static int FRAME_TICKS = 10; // 动画每帧持续的模拟步数
+};
+
+// 地面条带：在图集中被切成若干段（ATLAS_GROUND_SLICES），按顺序首尾相接为完整条带
+struct GroundConstants {
+    constexpr static int WIDTH = 2404;
+    constexpr static int HEIGHT = 18;
 };
 
 // 游戏区域
@@ -41,8 +69,15 @@ constexpr int CANVAS_HEIGHT = 800;
 constexpr int GROUND_Y = 600;
 constexpr int DINO_X = 100;
 
+// 帧调度
+constexpr float FIXED_STEP_MS = 16.67f; // 固定模拟步长（60FPS）
+constexpr int DEFAULT_MAX_STEPS_PER_FRAME = 4; // 每帧最多追赶的步数
+constexpr float DEFAULT_FRAME_BUDGET_MS = 4.0f; // 每帧用于追赶的 CPU 时间预算
+constexpr float MAX_BACKLOG_MS = 250.0f; // 快进模式下最多积压的时间，超出部分丢弃
+
 // 游戏逻辑
 constexpr int SCORE_INCREMENT_INTERVAL = 5; // 每5帧增加1分
+constexpr int SCORE_MILESTONE_INTERVAL = 100; // 每100分产生一次分数里程碑事件
 constexpr int OBSTACLE_SPAWN_RANGE_MIN = 1800; // 最小间隔增大，减少密集刷怪
 constexpr int OBSTACLE_SPAWN_RANGE_MAX = 2500;
 constexpr float GAME_SPEED_INCREASE_RATE = 0.005f; // 每400分增加2速度
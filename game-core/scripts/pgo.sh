@@ -0,0 +1,96 @@
+#!/usr/bin/env bash
+# 基于剖析的优化（PGO）流程：
+#   1. 基线：普通 Release 构建，以及打开 LTO 的 Release 构建
+#   2. DINO_PGO=GENERATE 插桩构建（同样打开 LTO），运行训练负载收集剖析数据：
+#      pgo_train 经 GameEngine::update 跑多局对局（浏览器路径），replay_verify 生成并校验
+#      一批回放（服务端路径）；clang 需再用 llvm-profdata 合并
+#   3. 同一构建目录以 DINO_PGO=USE 重新构建
+#   4. 在三个构建上运行回归基准（同时校验黄金文件，保证行为不变）与回放校验，输出加速比。
+#      训练种子从 100000 开始，与测量用的种子（回归基准 1/7/42/1234，回放 1..BENCH_REPLAYS）不重叠
+#
+# 用法: scripts/pgo.sh [输出目录]（默认 build-pgo）
+# 环境变量: PGO_GAMES 训练局数（默认 300），PGO_REPLAYS 训练回放局数（默认 500），
+#           BENCH_REPEAT 回归基准重复次数（默认 50），BENCH_REPLAYS 测量用回放局数（默认 20000），
+#           BENCH_ROUNDS 轮流测量的轮数（默认 5）
+set -euo pipefail
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=${1:-$ROOT/build-pgo}
+GAMES=${PGO_GAMES:-300}
+TRAIN_REPLAYS=${PGO_REPLAYS:-500}
+REPEAT=${BENCH_REPEAT:-50}
+REPLAYS=${BENCH_REPLAYS:-20000}
+ROUNDS=${BENCH_ROUNDS:-5}
+JOBS=$(nproc 2>/dev/null || echo 4)
+
+PROFILE=$OUT/pgo/pgo-profile
+
+# configure <构建目录> <DINO_PGO> <LTO ON/OFF>
+configure() {
+    cmake -S "$ROOT" -B "$1" -DCMAKE_BUILD_TYPE=Release -DDINO_PGO="$2" -DDINO_PGO_DIR="$PROFILE" \
+        -DCMAKE_INTERPROCEDURAL_OPTIMIZATION="$3" >/dev/null
+    cmake --build "$1" -j"$JOBS" >/dev/null
+}
+
+echo "== 基线构建"
+configure "$OUT/release" OFF OFF
+configure "$OUT/lto" OFF ON
+
+echo "== 插桩构建并训练"
+rm -rf "$PROFILE" "$OUT/train-replays"
+mkdir -p "$PROFILE" "$OUT/train-replays"
+configure "$OUT/pgo" GENERATE ON
+export LLVM_PROFILE_FILE="$PROFILE/%p-%m.profraw"
+"$OUT/pgo/pgo_train" --games "$GAMES" --seed 100000
+"$OUT/pgo/replay_verify" "$OUT/train-replays" --generate "$TRAIN_REPLAYS" --seed 100000 --tamper 5 >/dev/null
+"$OUT/pgo/replay_verify" "$OUT/train-replays" >/dev/null || true # 篡改的记录会使退出码非 0
+unset LLVM_PROFILE_FILE
+
+CLANG=0
+if grep -q 'CMAKE_CXX_COMPILER_ID "\(Apple\)\?Clang"' "$OUT"/pgo/CMakeFiles/*/CMakeCXXCompiler.cmake; then
+    CLANG=1
+    PROFDATA=${LLVM_PROFDATA:-$(command -v llvm-profdata || xcrun -f llvm-profdata)}
+    "$PROFDATA" merge -o "$PROFILE/default.profdata" "$PROFILE"/*.profraw
+fi
+
+echo "== 使用剖析数据重新构建"
+configure "$OUT/pgo" USE ON
+
+echo "== 测量（回归基准 best of $REPEAT，回放校验 $REPLAYS 局单线程，$ROUNDS 轮取最好）"
+rm -rf "$OUT/replays"
+mkdir -p "$OUT/replays"
+"$OUT/release/replay_verify" "$OUT/replays" --generate "$REPLAYS" >/dev/null
+
+# 回归基准总耗时（毫秒），行为变化时 regression_bench 返回非 0，脚本随之失败
+bench_total() {
+    "$1/regression_bench" --repeat "$REPEAT" | awk '/^total best time/ { sub("ms", "", $4); print $4 }'
+}
+
+replay_time() {
+    "$1/replay_verify" "$OUT/replays" --threads 1 | sed -n 's/.* time=\([0-9.]*\)s.*/\1/p'
+}
+
+# 三个构建轮流测量若干轮，各取最好成绩，减小机器负载波动的影响
+for round in $(seq "$ROUNDS"); do
+    for build in release lto pgo; do
+        echo "$build $(bench_total "$OUT/$build") $(replay_time "$OUT/$build")"
+    done
+done | awk '
+    !($1 in bench) || $2 < bench[$1] { bench[$1] = $2 }
+    !($1 in replay) || $3 < replay[$1] { replay[$1] = $3 }
+    END {
+        printf "%-10s %18s %16s\n", "", "regression_bench", "replay_verify"
+        split("release lto pgo", builds, " ")
+        for (i = 1; i <= 3; i++) {
+            b = builds[i]
+            printf "%-10s %9.3fms %6.1f%% %8.3fs %6.1f%%\n", b, bench[b], (bench["release"] / bench[b] - 1) * 100,
+                   replay[b], (replay["release"] / replay[b] - 1) * 100
+        }
+        printf "pgo vs lto: regression_bench %+.1f%%, replay_verify %+.1f%%\n",
+               (bench["lto"] / bench["pgo"] - 1) * 100, (replay["lto"] / replay["pgo"] - 1) * 100
+    }'
+
+if [ "$CLANG" = 1 ]; then
+    echo "WASM 构建可复用该剖析数据（需与 Emscripten 自带的 LLVM 版本兼容）:"
+    echo "  emcmake cmake -S $ROOT -B build-wasm -DDINO_PGO=USE -DDINO_PGO_DIR=$PROFILE"
+fi
@@ -2,6 +2,20 @@
 #include "Dino.hpp"
 #include "ObstacleManager.hpp"
 
+namespace {
+// 扫掠时刻 distance / velocity（velocity 不为 0），截断到 [-1, 2]。
+// 只关心 [0, 1) 内的时刻，截断不改变判定结果，同时避免定点除法在速度很小时溢出
+Scalar sweepTime(Scalar distance, Scalar velocity) {
+    if (velocity < 0.0f) {
+        distance = -distance;
+        velocity = -velocity;
+    }
+    if (distance >= velocity + velocity) return 2.0f;
+    if (distance <= -velocity) return -1.0f;
+    return distance / velocity;
+}
+}
+
 CollisionResult CollisionSystem::checkCollision(const Dino& dino, const ObstacleManager& obstacleManager) {
     Rect dinoBox = {
         dino.getBoundingBox().x,
@@ -10,16 +24,103 @@ CollisionResult CollisionSystem::checkCollision(const Dino& dino, const Obstacle
         dino.getBoundingBox().height
     };
     
-    for (const auto& obstacle : obstacleManager.getObstacles()) {
+    // 粗筛：只检查水平范围可能与恐龙重叠的障碍物
+    const auto& obstacles = obstacleManager.getObstacles();
+    size_t first = 0;
+    size_t last = 0;
+    obstacleManager.queryRange(dinoBox.x, dinoBox.x + dinoBox.width, first, last);
+
+    for (size_t i = first; i < last; i++) {
+        const auto& obstacle = obstacles[i];
         auto obsBox = obstacle.boundingBox();
         Rect obsRect = {obsBox.x, obsBox.y, obsBox.width, obsBox.height};
         
         if (rectIntersect(dinoBox, obsRect)) {
-            return {true, obstacle.type.c_str()};
+            return {true, obstacle.kind, Scalar(1.0f)};
         }
     }
     
-    return {false, ""};
+    return {false, -1, Scalar(1.0f)};
+}
+
+CollisionResult CollisionSystem::checkSweptCollision(const Rect& dinoStart, const Dino& dino,
+                                                     const ObstacleManager& obstacleManager,
+                                                     Scalar obstacleShift) {
+    auto dinoEnd = dino.getBoundingBox();
+
+    // 在障碍物参考系中计算：障碍物静止于本次更新结束时的位置，
+    // 恐龙从 (x - shift) 出发水平移动 shift，同时竖直移动 dy
+    Rect moving = {
+        dinoStart.x - obstacleShift,
+        dinoStart.y,
+        dinoStart.width,
+        dinoStart.height
+    };
+    Scalar dy = dinoEnd.y - dinoStart.y;
+
+    // 粗筛范围覆盖整个扫掠区间
+    const auto& obstacles = obstacleManager.getObstacles();
+    size_t first = 0;
+    size_t last = 0;
+    Scalar sweepLeft = moving.x < dinoEnd.x ? moving.x : dinoEnd.x;
+    Scalar sweepRight = (moving.x > dinoEnd.x ? moving.x : dinoEnd.x) + moving.width;
+    obstacleManager.queryRange(sweepLeft, sweepRight, first, last);
+
+    CollisionResult result = {false, -1, Scalar(1.0f)};
+    for (size_t i = first; i < last; i++) {
+        const auto& obstacle = obstacles[i];
+        auto obsBox = obstacle.boundingBox();
+        Rect obsRect = {obsBox.x, obsBox.y, obsBox.width, obsBox.height};
+
+        Scalar toi = 1.0f;
+        if (sweptIntersect(moving, obstacleShift, dy, obsRect, toi) && toi < result.timeOfImpact) {
+            result.collided = true;
+            result.obstacleKind = obstacle.kind;
+            result.timeOfImpact = toi;
+        }
+    }
+
+    return result;
+}
+
+bool CollisionSystem::sweptIntersect(const Rect& moving, Scalar vx, Scalar vy, const Rect& target, Scalar& toi) {
+    // 分轴求进入/离开时刻（slab 方法），与 rectIntersect 一样使用严格不等式。
+    // 某轴没有位移时该轴始终重叠，进入/离开时刻取截断范围的两端
+    Scalar entryX, exitX;
+    if (vx == 0.0f) {
+        if (!(moving.x < target.x + target.width && moving.x + moving.width > target.x)) return false;
+        entryX = -1.0f;
+        exitX = 2.0f;
+    } else if (vx > 0.0f) {
+        entryX = sweepTime(target.x - (moving.x + moving.width), vx);
+        exitX = sweepTime(target.x + target.width - moving.x, vx);
+    } else {
+        entryX = sweepTime(target.x + target.width - moving.x, vx);
+        exitX = sweepTime(target.x - (moving.x + moving.width), vx);
+    }
+
+    Scalar entryY, exitY;
+    if (vy == 0.0f) {
+        if (!(moving.y < target.y + target.height && moving.y + moving.height > target.y)) return false;
+        entryY = -1.0f;
+        exitY = 2.0f;
+    } else if (vy > 0.0f) {
+        entryY = sweepTime(target.y - (moving.y + moving.height), vy);
+        exitY = sweepTime(target.y + target.height - moving.y, vy);
+    } else {
+        entryY = sweepTime(target.y + target.height - moving.y, vy);
+        exitY = sweepTime(target.y - (moving.y + moving.height), vy);
+    }
+
+    Scalar entry = entryX > entryY ? entryX : entryY;
+    Scalar exit = exitX < exitY ? exitX : exitY;
+
+    if (entry >= exit || entry >= 1.0f || exit <= 0.0f) {
+        return false;
+    }
+
+    toi = entry > 0.0f ? entry : Scalar(0.0f);
+    return true;
 }
 
 bool CollisionSystem::rectIntersect(const Rect& rect1, const Rect& rect2) {
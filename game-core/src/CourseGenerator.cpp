@@ -0,0 +1,179 @@
+#include "CourseGenerator.hpp"
+#include "constants.hpp"
+#include "JumpArc.hpp"
+
+#include <ctime>
+
+namespace {
+// 每块赛道向前生成的世界距离（若干个屏幕宽度）
+constexpr float COURSE_CHUNK_DISTANCE = CANVAS_WIDTH * 4.0f;
+// 两组障碍物之间的最小距离，保证同一时刻屏幕上不会过于密集
+constexpr float MIN_ENTRY_GAP = CANVAS_WIDTH * 0.5f;
+// 开局额外延迟（毫秒），避免一开始太快
+constexpr float INITIAL_SPAWN_DELAY_MS = 800.0f;
+}
+
+CourseGenerator::CourseGenerator() : cursor(0), nextWorldX(0) {
+    random.seed(static_cast<uint32_t>(std::time(nullptr)));
+
+    // 按 ScoreManager 的规则预计算每个速度档位开始的世界距离：
+    // 分数每 SCORE_INCREMENT_INTERVAL 步加 1，速度 = 初始速度 + int(分数 * 增速)
+    Distance distance = 0.0f;
+    int lastScore = 0;
+    int level = 0;
+    speedLevelStart.push_back(distance);
+    for (int score = 1; INITIAL_GAME_SPEED + level < MAX_GAME_SPEED; score++) {
+        int newLevel = static_cast<int>(score * GAME_SPEED_INCREASE_RATE);
+        if (newLevel != level) {
+            distance += Distance((score - lastScore) * SCORE_INCREMENT_INTERVAL * (INITIAL_GAME_SPEED + level));
+            lastScore = score;
+            level = newLevel;
+            speedLevelStart.push_back(distance);
+        }
+    }
+
+    reset();
+}
+
+void CourseGenerator::setSeed(uint32_t seed) {
+    random.seed(seed);
+}
+
+void CourseGenerator::reset() {
+    entries.clear();
+    cursor = 0;
+    // 第一组障碍物：按初始速度的间距再额外延迟
+    Scalar pxPerMs = INITIAL_GAME_SPEED / 16.67f;
+    nextWorldX = Distance(nextGap(INITIAL_GAME_SPEED) + Scalar(INITIAL_SPAWN_DELAY_MS) * pxPerMs);
+}
+
+const CourseEntry& CourseGenerator::peek() {
+    if (cursor >= entries.size()) {
+        generateChunk();
+    }
+    return entries[cursor];
+}
+
+void CourseGenerator::advance() {
+    if (cursor < entries.size()) {
+        cursor++;
+    }
+}
+
+void CourseGenerator::generateUntil(Distance distance) {
+    appendUntil(distance);
+}
+
+const std::vector<CourseEntry>& CourseGenerator::getEntries() const {
+    return entries;
+}
+
+float CourseGenerator::speedAtDistance(Distance distance) const {
+    int level = 0;
+    while (level + 1 < static_cast<int>(speedLevelStart.size()) && distance >= speedLevelStart[level + 1]) {
+        level++;
+    }
+    float speed = INITIAL_GAME_SPEED + level;
+    return speed > MAX_GAME_SPEED ? MAX_GAME_SPEED : speed;
+}
+
+void CourseGenerator::generateChunk() {
+    // 丢弃已消费的部分，保留容量以复用内存
+    entries.erase(entries.begin(), entries.begin() + cursor);
+    cursor = 0;
+
+    appendUntil(nextWorldX + Distance(COURSE_CHUNK_DISTANCE));
+}
+
+void CourseGenerator::appendUntil(Distance distance) {
+    const JumpArc& arc = JumpArc::get();
+    const ObstacleConstants::Archetype* archetypes = ObstacleConstants::ARCHETYPES;
+
+    // 需要起跳越过的障碍物中最大的离地高度，用于保证下一组无论是什么都来得及起跳。
+    // 站着就能通过的（高空翼龙）不用跳，跳不到的也无从保证，都不计入
+    float tallestClearance = 0.0f;
+    for (int kind = 0; kind < ObstacleConstants::KIND_COUNT; kind++) {
+        float enter, exit;
+        if (arc.headroomFor(kind, false) >= 0.0f || !arc.clearWindow(arc.clearanceFor(kind), enter, exit)) continue;
+        if (arc.clearanceFor(kind) > tallestClearance) tallestClearance = arc.clearanceFor(kind);
+    }
+
+    while (nextWorldX < distance) {
+        float arrivalSpeed = speedAtDistance(nextWorldX + Distance(static_cast<float>(CANVAS_WIDTH)));
+
+        // 按权重在当前速度下可出现的种类中抽取
+        int totalWeight = 0;
+        for (int kind = 0; kind < ObstacleConstants::KIND_COUNT; kind++) {
+            if (arrivalSpeed >= archetypes[kind].MIN_SPEED) totalWeight += archetypes[kind].SPAWN_WEIGHT;
+        }
+        int pick = random.nextInt(totalWeight);
+        int type = 0;
+        for (int kind = 0; kind < ObstacleConstants::KIND_COUNT; kind++) {
+            if (arrivalSpeed < archetypes[kind].MIN_SPEED) continue;
+            type = kind;
+            pick -= archetypes[kind].SPAWN_WEIGHT;
+            if (pick < 0) break;
+        }
+        const ObstacleConstants::Archetype& archetype = archetypes[type];
+
+        CourseEntry entry;
+        entry.worldX = nextWorldX;
+        entry.type = static_cast<uint8_t>(type);
+        entry.count = static_cast<uint8_t>(random.nextInt(archetype.MAX_GROUP) + 1);
+        entry.variantMask = 0;
+        for (int i = 0; i < entry.count; i++) {
+            entry.variantMask |= static_cast<uint8_t>(random.nextInt(2) << i);
+        }
+        entry.reserved = 0;
+
+        // 生成时剔除无法越过的组合：按到达恐龙附近时的速度查跳跃轨迹表，
+        // 整组宽度超出跳跃窗口时减少数量
+        float clearance = arc.clearanceFor(type);
+        while (entry.count > 1 && !arc.isClearable(JumpArc::groupSpan(type, entry.count), clearance, arrivalSpeed)) {
+            entry.count--;
+        }
+        entries.push_back(entry);
+
+        // 间距由出现位置处的速度决定；并保证越过这一组落地后，
+        // 无论下一组是什么障碍物都还来得及起跳（本组站着就能通过时不会起跳，没有这一约束）
+        Scalar gap = nextGap(speedAtDistance(nextWorldX));
+        float minGap = 0.0f;
+        if (arc.headroomFor(type, false) < 0.0f &&
+            arc.minFollowDistance(clearance, tallestClearance, arrivalSpeed, minGap) && gap < Scalar(minGap)) {
+            gap = minGap;
+        }
+        nextWorldX += Distance(gap);
+    }
+}
+
+Scalar CourseGenerator::nextGap(float gameSpeed) {
+    // gameSpeed currently is in pixels-per-frame.
+    // Convert to pixels-per-ms: px_per_ms = gameSpeed / 16.67
+    // 以下运算使用 Scalar，定点模式下生成时间同样逐位确定
+    Scalar pxPerMs = Scalar((gameSpeed > 0.0f) ? gameSpeed : INITIAL_GAME_SPEED) / Scalar(16.67f);
+
+    // Desired gap in pixels increases with speed to avoid visual crowding at high speed.
+    const Scalar baseGap = 900.0f; // 基准像素距离
+    const Scalar gapPerSpeed = 30.0f; // 每单位速度增加的像素距离
+    const Scalar minGap = 600.0f;
+    const Scalar maxGap = 2000.0f;
+
+    Scalar desiredGap = baseGap + gapPerSpeed * Scalar(gameSpeed - INITIAL_GAME_SPEED);
+    if (desiredGap < minGap) desiredGap = minGap;
+    if (desiredGap > maxGap) desiredGap = maxGap;
+
+    // Add a random jitter (±30%) to avoid perfect regularity
+    // jitter range: [0.7, 1.3]
+    Scalar jitter = Scalar(0.7f) + Scalar(random.nextFloat()) * Scalar(0.6f);
+    desiredGap *= jitter;
+
+    // 间距对应的时间限制在合理范围内，避免过于稀疏或密集
+    const Scalar minMs = 1800.0f; // 最小 1800ms（用户要求）
+    const Scalar maxMs = 4000.0f; // 最大 4s
+    Scalar gap = desiredGap;
+    if (gap < minMs * pxPerMs) gap = minMs * pxPerMs;
+    if (gap > maxMs * pxPerMs) gap = maxMs * pxPerMs;
+    if (gap < Scalar(MIN_ENTRY_GAP)) gap = MIN_ENTRY_GAP;
+
+    return gap;
+}
@@ -11,14 +11,17 @@ void Dino::reset() {
     width = DinoConstants::WIDTH;
     height = DinoConstants::HEIGHT;
     isJumping = false;
+    isDucking = false;
+    duckHeld = false;
     isDead = false;
     isOnGround = true;
+    animCounter = 0;
     currentSprite = DinoConstants::RUN_1;
 }
 
 void Dino::update(float deltaTime) {
     // deltaTime 以毫秒为单位，使用帧数比例计算位置与速度变化
-    float frames = deltaTime / 16.67f;
+    Scalar frames = deltaTime / 16.67f;
     if (!isOnGround) {
         yVelocity += GRAVITY * frames;
     }
@@ -34,11 +37,12 @@ void Dino::update(float deltaTime) {
         isOnGround = false;
     }
     
+    applyPosture();
     updateSprite();
 }
 
 bool Dino::jump() {
-    if (!isJumping && !isDead) {
+    if (!isJumping && !isDead && !isDucking) {
         yVelocity = JUMP_FORCE;
         isJumping = true;
         return true;
@@ -46,29 +50,56 @@ bool Dino::jump() {
     return false;
 }
 
+void Dino::setDucking(bool held) {
+    duckHeld = held;
+    applyPosture();
+}
+
+void Dino::applyPosture() {
+    bool duck = duckHeld && isOnGround && !isDead;
+    if (duck == isDucking) return;
+
+    // 下蹲只发生在地面上，切换时脚的位置不变
+    isDucking = duck;
+    width = duck ? DinoConstants::DUCK_WIDTH : DinoConstants::WIDTH;
+    height = duck ? DinoConstants::DUCK_HEIGHT : DinoConstants::HEIGHT;
+    y = GROUND_Y - height;
+}
+
 void Dino::die() {
     isDead = true;
+    applyPosture(); // 站起来显示死亡精灵
     currentSprite = DinoConstants::DEAD;
 }
 
+void Dino::moveTo(Scalar newY) {
+    y = newY;
+}
+
 Dino::State Dino::getState() const {
     State state;
     state.x = x;
-    state.y = y;
+    state.y = toFloat(y);
+    state.yVelocity = toFloat(yVelocity);
     state.width = width;
     state.height = height;
     state.isJumping = isJumping;
+    state.isDucking = isDucking;
     state.isDead = isDead;
     state.sprite = {currentSprite.x, currentSprite.y, currentSprite.w, currentSprite.h};
     return state;
 }
 
+Scalar Dino::getY() const {
+    return y;
+}
+
 Dino::BoundingBox Dino::getBoundingBox() const {
     BoundingBox box;
-    box.x = x + 10;
-    box.y = y + 10;
-    box.width = width - 20;
-    box.height = height - 20;
+    box.x = Scalar(x + 10);
+    box.y = y + Scalar(10.0f);
+    box.width = Scalar(static_cast<float>(width - 20));
+    box.height = Scalar(static_cast<float>(height - 20));
     return box;
 }
 
@@ -79,9 +110,12 @@ void Dino::updateSprite() {
         currentSprite = DinoConstants::JUMP;
     } else {
         // 简单的基于帧切换动画
-        static int counter = 0;
-        counter = (counter + 1) % 10; // 每10次update切换一次
-        int frame = (counter < 5) ? 0 : 1;
-        currentSprite = (frame == 0) ? DinoConstants::RUN_1 : DinoConstants::RUN_2;
+        animCounter = (animCounter + 1) % 10; // 每10次update切换一次
+        int frame = (animCounter < 5) ? 0 : 1;
+        if (isDucking) {
+            currentSprite = (frame == 0) ? DinoConstants::DUCK_1 : DinoConstants::DUCK_2;
+        } else {
+            currentSprite = (frame == 0) ? DinoConstants::RUN_1 : DinoConstants::RUN_2;
+        }
     }
 }
@@ -0,0 +1,43 @@
+#include "EventQueue.hpp"
+
+EventQueue::EventQueue() {
+    ring.head.store(0, std::memory_order_relaxed);
+    ring.tail.store(0, std::memory_order_relaxed);
+    ring.capacity = EVENT_RING_CAPACITY;
+    ring.dropped = 0;
+}
+
+bool EventQueue::push(int32_t type, int32_t a, int32_t b, int32_t tick) {
+    uint32_t head = ring.head.load(std::memory_order_relaxed);
+    uint32_t tail = ring.tail.load(std::memory_order_acquire);
+    if (head - tail >= EVENT_RING_CAPACITY) {
+        ring.dropped++;
+        return false;
+    }
+
+    EngineEvent& event = ring.events[head & (EVENT_RING_CAPACITY - 1)];
+    event.type = type;
+    event.a = a;
+    event.b = b;
+    event.tick = tick;
+
+    // 先写入事件内容，再发布 head
+    ring.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool EventQueue::pop(EngineEvent& event) {
+    uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint32_t head = ring.head.load(std::memory_order_acquire);
+    if (tail == head) {
+        return false;
+    }
+
+    event = ring.events[tail & (EVENT_RING_CAPACITY - 1)];
+    ring.tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+EventRing* EventQueue::getRing() {
+    return &ring;
+}
@@ -0,0 +1,110 @@
+#include "FrameScheduler.hpp"
+#include "constants.hpp"
+
+FrameScheduler::FrameScheduler()
+    : policy(Policy::PAUSE_ON_HIDDEN),
+      maxStepsPerFrame(DEFAULT_MAX_STEPS_PER_FRAME),
+      budgetMs(DEFAULT_FRAME_BUDGET_MS),
+      hidden(false),
+      lastTime(0),
+      hasLastTime(false),
+      accumulator(0),
+      stepsThisFrame(0),
+      pendingCounted(0) {
+    stats.simulatedTicks = 0;
+    stats.droppedTicks = 0;
+    stats.budgetExceededTicks = 0;
+}
+
+void FrameScheduler::resetClock() {
+    hasLastTime = false;
+    accumulator = 0;
+    pendingCounted = 0;
+}
+
+void FrameScheduler::setPolicy(Policy newPolicy) {
+    policy = newPolicy;
+}
+
+FrameScheduler::Policy FrameScheduler::getPolicy() const {
+    return policy;
+}
+
+void FrameScheduler::setBudget(int maxSteps, float budget) {
+    maxStepsPerFrame = maxSteps > 0 ? maxSteps : 1;
+    budgetMs = budget > 0.0f ? budget : 0.0f;
+}
+
+void FrameScheduler::setHidden(bool isHidden) {
+    if (hidden == isHidden) return;
+    hidden = isHidden;
+
+    // 冻结时钟：隐藏期间的时间既不模拟也不计为丢弃
+    if (policy == Policy::PAUSE_ON_HIDDEN) {
+        resetClock();
+    }
+}
+
+void FrameScheduler::beginFrame(float currentTime) {
+    stepsThisFrame = 0;
+    frameStart = std::chrono::steady_clock::now();
+
+    if (hidden && policy == Policy::PAUSE_ON_HIDDEN) {
+        hasLastTime = false;
+        return;
+    }
+
+    if (!hasLastTime) {
+        // 第一帧，只模拟一步
+        accumulator += FIXED_STEP_MS;
+    } else if (currentTime > lastTime) {
+        accumulator += currentTime - lastTime;
+    }
+    lastTime = currentTime;
+    hasLastTime = true;
+
+    // 快进模式下积压过多时丢弃最旧的部分，避免越追越慢
+    if (accumulator > MAX_BACKLOG_MS) {
+        int dropped = static_cast<int>((accumulator - MAX_BACKLOG_MS) / FIXED_STEP_MS);
+        stats.droppedTicks += dropped;
+        accumulator -= dropped * FIXED_STEP_MS;
+        pendingCounted = 0;
+    }
+}
+
+bool FrameScheduler::nextStep() {
+    if (accumulator < FIXED_STEP_MS) return false;
+    if (stepsThisFrame >= maxStepsPerFrame) return false;
+
+    // 第一步总是执行，之后检查本帧已用的 CPU 时间
+    if (stepsThisFrame > 0) {
+        std::chrono::duration<float, std::milli> used = std::chrono::steady_clock::now() - frameStart;
+        if (used.count() >= budgetMs) return false;
+    }
+
+    accumulator -= FIXED_STEP_MS;
+    stepsThisFrame++;
+    stats.simulatedTicks++;
+    return true;
+}
+
+void FrameScheduler::endFrame() {
+    int pending = static_cast<int>(accumulator / FIXED_STEP_MS);
+
+    // 顺延到下一帧的步只计一次
+    if (pending > pendingCounted) {
+        stats.budgetExceededTicks += pending - pendingCounted;
+    }
+    pendingCounted = pending;
+
+    if (pending > 0 && policy == Policy::DROP) {
+        // 丢弃整步，保留不足一步的余量以保持节奏
+        stats.droppedTicks += pending;
+        accumulator -= pending * FIXED_STEP_MS;
+        pendingCounted = 0;
+    }
+}
+
+FrameScheduler::Stats FrameScheduler::getStats() const {
+    return stats;
+}
@@ -1,14 +1,15 @@
 #include "GameBridge.hpp"
 #include "GameEngine.hpp"
+#include "RenderList.hpp"
+#include "FrameScheduler.hpp"
+#include "ScoreStore.hpp"
+#include "EventQueue.hpp"
+#include "MemoryStats.hpp"
+#include "InputTransport.hpp"
+#include "VersusSession.hpp"
 
 #ifdef __EMSCRIPTEN__
 // 在这里定义 EM_JS 函数，避免重复
-EM_JS(void, js_save_high_score, (int score), {
-    if (typeof window !== 'undefined' && window.localStorage) {
-        localStorage.setItem('dino_high_score', score.toString());
-    }
-});
-
 EM_JS(int, js_load_high_score, (), {
     if (typeof window !== 'undefined' && window.localStorage) {
         const saved = localStorage.getItem('dino_high_score');
@@ -20,6 +21,14 @@ EM_JS(int, js_load_high_score, (), {
 
 static GameEngine* engine = nullptr;
 
+// 对战会话与队列传输在第一次开局时创建，之后复用
+static VersusSession* versus = nullptr;
+static QueueTransport* versusTransport = nullptr;
+
+static bool versusActive() {
+    return versus && versus->isActive();
+}
+
 void game_init() {
     if (!engine) {
         engine = new GameEngine();
@@ -37,19 +46,33 @@ void game_start() {
 }
 
 void game_update(float currentTime) {
-    if (engine) {
+    if (versusActive()) {
+        versus->update(currentTime);
+    } else if (engine) {
         engine->update(currentTime);
     }
 }
 
 int game_jump() {
+    if (versusActive()) {
+        return versus->jump() ? 1 : 0;
+    }
     if (engine) {
         return engine->jump() ? 1 : 0;
     }
     return 0;
 }
 
+void game_duck(int held) {
+    if (versusActive()) {
+        versus->duck(held != 0);
+    } else if (engine) {
+        engine->duck(held != 0);
+    }
+}
+
 void game_restart() {
+    game_versus_stop();
     if (engine) {
         engine->reset();
     }
@@ -90,4 +113,186 @@ int game_get_high_score() {
         return engine->getHighScore();
     }
     return 0;
-}
\ No newline at end of file
+}
+
+float* game_get_render_list() {
+    if (engine) {
+        return const_cast<float*>(engine->getRenderList().data());
+    }
+    return nullptr;
+}
+
+int game_get_render_list_count() {
+    if (engine) {
+        return engine->getRenderList().count();
+    }
+    return 0;
+}
+
+void game_set_schedule_policy(int policy) {
+    if (engine && policy >= 0 && policy <= 2) {
+        engine->getFrameScheduler().setPolicy(static_cast<FrameScheduler::Policy>(policy));
+    }
+}
+
+void game_set_step_budget(int maxStepsPerFrame, float budgetMs) {
+    if (engine) {
+        engine->getFrameScheduler().setBudget(maxStepsPerFrame, budgetMs);
+    }
+}
+
+void game_set_hidden(int hidden) {
+    if (engine) {
+        engine->getFrameScheduler().setHidden(hidden != 0);
+    }
+}
+
+int game_get_simulated_ticks() {
+    if (engine) {
+        return engine->getFrameScheduler().getStats().simulatedTicks;
+    }
+    return 0;
+}
+
+int game_get_dropped_ticks() {
+    if (engine) {
+        return engine->getFrameScheduler().getStats().droppedTicks;
+    }
+    return 0;
+}
+
+int game_get_budget_exceeded_ticks() {
+    if (engine) {
+        return engine->getFrameScheduler().getStats().budgetExceededTicks;
+    }
+    return 0;
+}
+
+void game_set_seed(unsigned int seed) {
+    if (engine) {
+        engine->setSeed(seed);
+    }
+}
+
+void game_score_store_ingest(int mode, int score) {
+    if (engine) {
+        engine->ingestScore(mode, score);
+    }
+}
+
+void game_set_leaderboard_mode(int mode) {
+    if (engine) {
+        engine->setLeaderboardMode(mode);
+    }
+}
+
+int* game_get_leaderboard(int mode) {
+    if (engine) {
+        return const_cast<int*>(engine->getScoreStore().top(mode));
+    }
+    return nullptr;
+}
+
+int game_get_leaderboard_count(int mode) {
+    if (engine) {
+        return engine->getScoreStore().topCount(mode);
+    }
+    return 0;
+}
+
+float game_get_score_percentile(int mode, int score) {
+    if (engine) {
+        return engine->getScoreStore().percentile(mode, score);
+    }
+    return 0.0f;
+}
+
+void game_set_autoplay(int enabled) {
+    if (engine) {
+        engine->setAutoplay(enabled != 0);
+    }
+}
+
+void* game_get_event_ring() {
+    if (engine) {
+        return engine->getEventQueue().getRing();
+    }
+    return nullptr;
+}
+
+unsigned int* game_get_memory_stats() {
+    static MemoryStats stats;
+    readMemoryStats(stats);
+    stats.stateBufferBytes = engine ? static_cast<uint32_t>(engine->getStateBufferBytes()) : 0;
+    return reinterpret_cast<unsigned int*>(&stats);
+}
+void game_versus_start(unsigned int seed) {
+    if (!engine) return;
+    if (!versus) {
+        versus = new VersusSession();
+        versusTransport = new QueueTransport();
+    }
+    versusTransport->clear();
+    versus->start(engine, versusTransport, seed);
+}
+
+void game_versus_stop() {
+    if (versusActive()) {
+        versus->stop();
+        versusTransport->clear();
+    }
+}
+
+void* game_versus_take_packet() {
+    static InputPacket packet;
+    if (versusActive() && versusTransport->takeOutbound(packet)) {
+        return &packet;
+    }
+    return nullptr;
+}
+
+static InputPacket inboundPacket;
+
+void* game_versus_packet_buffer() {
+    return &inboundPacket;
+}
+
+int game_versus_push_packet() {
+    if (!versusActive() || inboundPacket.count > static_cast<uint32_t>(VERSUS_PACKET_INPUTS)) {
+        return 0;
+    }
+    versusTransport->pushInbound(inboundPacket);
+    return 1;
+}
+
+float* game_versus_get_state() {
+    static float state[VERSUS_STATE_SIZE];
+    for (int i = 0; i < VERSUS_STATE_SIZE; i++) {
+        state[i] = 0.0f;
+    }
+    if (!versus || !engine) return state;
+
+    GameEngine& remote = versus->getRemote();
+    const GameEngine::RenderState render = remote.getStateForRender();
+    const VersusSession::Stats& stats = versus->getStats();
+    state[0] = versus->isActive() ? 1.0f : 0.0f;
+    state[1] = static_cast<float>(versus->getOutcome());
+    state[2] = static_cast<float>(remote.getTickCount());
+    state[3] = static_cast<float>(versus->getRemoteConfirmedTick());
+    state[4] = static_cast<float>(render.score.score);
+    state[5] = static_cast<float>(render.gameState);
+    state[6] = render.dino.x;
+    state[7] = render.dino.y;
+    state[8] = static_cast<float>(render.dino.width);
+    state[9] = static_cast<float>(render.dino.height);
+    state[10] = static_cast<float>(render.dino.sprite.x);
+    state[11] = static_cast<float>(render.dino.sprite.y);
+    state[12] = static_cast<float>(render.dino.sprite.w);
+    state[13] = static_cast<float>(render.dino.sprite.h);
+    state[14] = static_cast<float>(stats.rollbacks);
+    state[15] = static_cast<float>(stats.maxRollbackDepth);
+    state[16] = static_cast<float>(stats.stalledFrames);
+    state[17] = stats.lastRollbackMs;
+    state[18] = stats.maxRollbackMs;
+    return state;
+}
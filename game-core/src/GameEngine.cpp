@@ -4,15 +4,34 @@
 #include "CollisionSystem.hpp"
 #include "ScoreManager.hpp"
 #include "GameState.hpp"
+#include "RenderList.hpp"
+#include "FrameScheduler.hpp"
+#include "ScoreStore.hpp"
+#include "JumpArc.hpp"
+#include "EventQueue.hpp"
+#include "EngineSnapshot.hpp"
 #include "constants.hpp"
 
 #include <cstring>
 #include <cmath>
 #include <vector>
 
-// 简单内存管理
-static float* flattenedState = nullptr;
-static int flattenedStateSize = 0;
+namespace {
+// 与 getStateForRender 中 gameState 的编码一致，PAUSED 为 3
+int stateCode(GameState::State state) {
+    switch (state) {
+        case GameState::State::PLAYING:
+            return 1;
+        case GameState::State::GAME_OVER:
+            return 2;
+        case GameState::State::PAUSED:
+            return 3;
+        case GameState::State::IDLE:
+        default:
+            return 0;
+    }
+}
+}
 
 GameEngine::GameEngine() {
     dino = new Dino();
@@ -20,34 +39,48 @@ GameEngine::GameEngine() {
     collisionSystem = new CollisionSystem();
     scoreManager = new ScoreManager();
     gameState = new GameState();
+    renderList = new RenderList();
+    frameScheduler = new FrameScheduler();
+    scoreStore = new ScoreStore();
+    eventQueue = new EventQueue();
+    leaderboardMode = 0;
+    autoplay = false;
+    scoreRecording = true;
+    gameOverInfo = GameOverInfo();
+    flattenedState = nullptr;
+    flattenedStateSize = 0;
     
     gameSpeed = INITIAL_GAME_SPEED;
-    lastTime = 0;
     groundOffset = 0;
+    tickCount = 0;
     
     // 加载最高分
     loadHighScore();
+    buildRenderList();
     
-    gameState->onStateChange = [this](GameState::State newState, GameState::State oldState) {
-        // 避免递归的检查
-        if (newState == oldState) return;
+    gameState->setOnStateChange(&GameEngine::handleStateChange, this);
+}
+
+void GameEngine::handleStateChange(void* userData, GameState::State newState, GameState::State oldState) {
+    GameEngine* self = static_cast<GameEngine*>(userData);
 
-        switch (newState) {
+    // 避免递归的检查
+    if (newState == oldState) return;
+
+    self->eventQueue->push(EVENT_STATE_CHANGE, stateCode(newState), stateCode(oldState), self->tickCount);
+
+    switch (newState) {
         case GameState::State::GAME_OVER:
-            saveHighScore();
+            if (self->scoreRecording) {
+                self->recordScore();
+            }
             break;
-         case GameState::State::IDLE:
-         case GameState::State::PLAYING:
-         case GameState::State::PAUSED:
-        // 这些状态不需要特殊处理
-        break;
-}
-        // switch (newState) {
-        //     case GameState::State::GAME_OVER:
-        //         saveHighScore();
-        //         break;
-        // }
-    };
+        case GameState::State::IDLE:
+        case GameState::State::PLAYING:
+        case GameState::State::PAUSED:
+            // 这些状态不需要特殊处理
+            break;
+    }
 }
 
 GameEngine::~GameEngine() {
@@ -56,11 +89,12 @@ GameEngine::~GameEngine() {
     delete collisionSystem;
     delete scoreManager;
     delete gameState;
+    delete renderList;
+    delete frameScheduler;
+    delete scoreStore;
+    delete eventQueue;
     
-    if (flattenedState) {
-        delete[] flattenedState;
-        flattenedState = nullptr;
-    }
+    delete[] flattenedState;
 }
 
 bool GameEngine::start() {
@@ -73,11 +107,12 @@ bool GameEngine::start() {
         // 直接设置状态
         gameState->setState(GameState::State::PLAYING);
         //reset();
-        lastTime = 0; // 会在update中设置
+        frameScheduler->resetClock(); // 第一帧在update中按一步处理
 
         // 确保恐龙处于正常状态
         if (dino->getState().isDead) {
             dino->reset();
+            buildRenderList();
         }
 
         return true;
@@ -91,6 +126,8 @@ bool GameEngine::reset() {
     scoreManager->reset();
     gameSpeed = INITIAL_GAME_SPEED;
     groundOffset = 0;
+    tickCount = 0;
+    buildRenderList();
 
     if (gameState->canTransitionTo(GameState::State::IDLE)) {
         gameState->setState(GameState::State::IDLE);
@@ -102,29 +139,133 @@ bool GameEngine::reset() {
 void GameEngine::update(float currentTime) {
     if (!gameState->isPlaying()) return;
 
-    // 计算时间增量
-    //float deltaTime = (lastTime == 0) ? 0 : (currentTime - lastTime);
-    // 计算时间增量（使用毫秒），并限制范围以避免跳帧过大
-    float deltaMs;
+    // 按固定步长推进模拟，卡顿后的追赶量由调度器按策略和预算控制
+    frameScheduler->beginFrame(currentTime);
+    while (gameState->isPlaying() && frameScheduler->nextStep()) {
+        step(FIXED_STEP_MS);
+    }
+    frameScheduler->endFrame();
 
-    if (lastTime == 0) {
-        // 第一帧，使用约一帧的默认值（16.67ms -> 60FPS）
-        deltaMs = 16.67f;
-    } else {
-        deltaMs = currentTime - lastTime; // currentTime 是毫秒
+    buildRenderList();
+}
+
+void GameEngine::setSeed(uint32_t seed) {
+    obstacleManager->setSeed(seed);
+}
+
+void GameEngine::tick() {
+    if (!gameState->isPlaying()) return;
+    step(FIXED_STEP_MS);
+}
+
+int GameEngine::getTickCount() const {
+    return tickCount;
+}
+
+void GameEngine::setAutoplay(bool enabled) {
+    autoplay = enabled;
+}
+
+bool GameEngine::isAutoplay() const {
+    return autoplay;
+}
+
+void GameEngine::saveSnapshot(EngineSnapshot& snapshot) const {
+    // 按值拷贝组件：快照重复使用时 vector 复用已有容量，不会分配内存
+    snapshot.dino = *dino;
+    snapshot.obstacles = *obstacleManager;
+    snapshot.score = *scoreManager;
+    snapshot.state = gameState->get();
+    snapshot.gameSpeed = gameSpeed;
+    snapshot.groundOffset = groundOffset;
+    snapshot.tickCount = tickCount;
+}
+
+void GameEngine::loadSnapshot(const EngineSnapshot& snapshot) {
+    *dino = snapshot.dino;
+    *obstacleManager = snapshot.obstacles;
+    *scoreManager = snapshot.score;
+    gameState->restore(snapshot.state);
+    gameSpeed = snapshot.gameSpeed;
+    groundOffset = snapshot.groundOffset;
+    tickCount = snapshot.tickCount;
+}
+
+void GameEngine::setScoreRecording(bool enabled) {
+    scoreRecording = enabled;
+}
+
+void GameEngine::autoplayStep() {
+    auto dinoState = dino->getState();
+    if (dinoState.isJumping || dinoState.isDead) return;
+
+    const JumpArc& arc = JumpArc::get();
+    const float dinoRight = arc.getDinoBoxRight();
+    const float dinoLeft = dinoRight - arc.getDinoBoxWidth();
+    const float speed = toFloat(gameSpeed);
+    const auto& obstacles = obstacleManager->getObstacles();
+
+    // 障碍物按 x 有序：找到第一组还没越过、且站立时会撞上的障碍物（同组障碍物首尾相接）。
+    // 从头顶飞过的障碍物不用理会
+    size_t i = 0;
+    while (i < obstacles.size()) {
+        auto box = obstacles[i].boundingBox();
+        if (toFloat(box.x + box.width) > dinoLeft && arc.headroomFor(obstacles[i].kind, false) < 0.0f) break;
+        i++;
+    }
+    if (i == obstacles.size()) {
+        dino->setDucking(false);
+        return;
+    }
+
+    auto firstBox = obstacles[i].boundingBox();
+    const float firstLeft = toFloat(firstBox.x);
+    float groupRight = toFloat(firstBox.x + firstBox.width);
+    float clearance = arc.clearanceFor(obstacles[i].kind);
+    bool duckUnder = arc.headroomFor(obstacles[i].kind, true) >= 0.0f;
+    for (size_t j = i + 1; j < obstacles.size(); j++) {
+        const Obstacle& prev = obstacles[j - 1];
+        if (toFloat(obstacles[j].x) - (toFloat(prev.x) + prev.width) > 1.0f) break;
+        auto box = obstacles[j].boundingBox();
+        groupRight = toFloat(box.x + box.width);
+        float nextClearance = arc.clearanceFor(obstacles[j].kind);
+        if (nextClearance > clearance) clearance = nextClearance;
+        duckUnder = duckUnder && arc.headroomFor(obstacles[j].kind, true) >= 0.0f;
+    }
 
-        // 限制 deltaMs 范围，避免异常情况
-        if (deltaMs > 50.0f) deltaMs = 50.0f; // 最大限制为 50ms (~20FPS)
-        if (deltaMs < 1.0f) deltaMs = 1.0f; // 最小 1ms
+    // 下蹲能通过的障碍物：快到时蹲下，越过后站起
+    if (duckUnder) {
+        dino->setDucking(firstLeft - arc.getDuckBoxRight() <= 2.0f * speed);
+        return;
     }
+    dino->setDucking(false);
 
-    lastTime = currentTime;
+    if (arc.shouldJump(firstLeft - dinoRight, groupRight - firstLeft, clearance, speed) &&
+        dino->jump()) {
+        eventQueue->push(EVENT_JUMP, 1, 0, tickCount);
+    }
+}
+
+void GameEngine::step(float deltaMs) {
+    tickCount++;
+
+    if (autoplay) {
+        autoplayStep();
+    }
 
     // 将 gameSpeed（以每帧单位为基准）按帧数缩放
-    float frames = deltaMs / 16.67f;
+    Scalar frames = deltaMs / 16.67f;
+    Scalar scrollDistance = gameSpeed * frames;
+
+    // 记录更新前的恐龙包围盒，用于连续碰撞检测
+    auto dinoStartBox = dino->getBoundingBox();
+    Scalar dinoStartY = dino->getY();
+    int scoreBefore = scoreManager->score;
+    Scalar speedBefore = gameSpeed;
+    Rect dinoStart = {dinoStartBox.x, dinoStartBox.y, dinoStartBox.width, dinoStartBox.height};
 
     // 更新地面滚动（以帧为单位移动）
-    groundOffset = fmod(groundOffset + gameSpeed * frames, 2404.0f);
+    groundOffset = wrap(groundOffset + scrollDistance, Scalar(GroundConstants::WIDTH));
 
     // 更新各个模块（以毫秒或帧为单位，模块内部负责如何使用）
     dino->update(deltaMs);
@@ -134,74 +275,113 @@ void GameEngine::update(float currentTime) {
     // 更新游戏速度（基于分数）
     gameSpeed = scoreManager->getGameSpeed(INITIAL_GAME_SPEED);
 
-    // 检测碰撞
-    const auto& obstacles = obstacleManager->getObstacles();
-    auto collisionResult = collisionSystem->checkCollision(*dino, *obstacleManager);
+    if (scoreManager->score / SCORE_MILESTONE_INTERVAL != scoreBefore / SCORE_MILESTONE_INTERVAL) {
+        eventQueue->push(EVENT_SCORE_MILESTONE, scoreManager->score, 0, tickCount);
+    }
+    if (gameSpeed != speedBefore) {
+        eventQueue->push(EVENT_SPEED_CHANGE, static_cast<int32_t>(toFloat(gameSpeed)), 0, tickCount);
+    }
+
+    // 检测碰撞（扫掠检测，步长较大时也不会漏判）
+    auto collisionResult = collisionSystem->checkSweptCollision(dinoStart, *dino, *obstacleManager, scrollDistance);
 
     if (collisionResult.collided && !dino->getState().isDead) {
+        // 回退到碰撞发生的时刻，使画面停在真实的接触位置
+        Scalar rewind = Scalar(1.0f) - collisionResult.timeOfImpact;
+        if (rewind > 0.0f) {
+            Scalar endY = dino->getY();
+            dino->moveTo(dinoStartY + (endY - dinoStartY) * collisionResult.timeOfImpact);
+            obstacleManager->shift(scrollDistance * rewind);
+            groundOffset = wrap(groundOffset - scrollDistance * rewind, Scalar(GroundConstants::WIDTH));
+        }
+        eventQueue->push(EVENT_COLLISION, collisionResult.obstacleKind, scoreManager->score, tickCount);
         gameOver();
     }
 }
 
 bool GameEngine::jump() {
-    if (gameState->isPlaying()) {
-        return dino->jump();
+    if (gameState->isPlaying() && dino->jump()) {
+        eventQueue->push(EVENT_JUMP, 0, 0, tickCount);
+        return true;
     }
     return false;
 }
 
-void* GameEngine::gameOver() {
+void GameEngine::duck(bool held) {
+    // 松开总是生效，避免游戏结束时按住的状态带到下一局
+    if (gameState->isPlaying() || !held) {
+        dino->setDucking(held);
+    }
+}
+
+const GameEngine::GameOverInfo* GameEngine::gameOver() {
     dino->die();
     bool newRecord = scoreManager->updateHighScore();
+    if (newRecord) {
+        eventQueue->push(EVENT_NEW_RECORD, scoreManager->highScore, 0, tickCount);
+    }
 
     if (gameState->canTransitionTo(GameState::State::GAME_OVER)) {
+        // 状态切换回调中会记录本局分数（只写一次）
         gameState->setState(GameState::State::GAME_OVER);
-        
-        // 保存最高分
-        saveHighScore();
-
-        // 创建返回结果
-        static struct {
-            bool newRecord;
-            int finalScore;
-            int highScore;
-        } result;
-        
-        result.newRecord = newRecord;
-        result.finalScore = scoreManager->score;
-        result.highScore = scoreManager->highScore;
-        
-        return &result;
+
+        gameOverInfo.newRecord = newRecord;
+        gameOverInfo.finalScore = scoreManager->score;
+        gameOverInfo.highScore = scoreManager->highScore;
+        return &gameOverInfo;
     }
     return nullptr;
 }
 
-void GameEngine::saveHighScore() {
-#ifdef __EMSCRIPTEN__
-    
-    js_save_high_score(scoreManager->highScore);
-#else
-    // 对于非WebAssembly环境，可以使用文件或其他存储方式
-    printf("High score saved: %d\n", scoreManager->highScore);
-#endif
+void GameEngine::recordScore() {
+    // 浏览器中异步写入 IndexedDB，原生环境追加到日志并批量 fsync，都不会阻塞帧循环
+    scoreStore->record(leaderboardMode, scoreManager->score);
 }
 
 void GameEngine::loadHighScore() {
+    int loadedScore = scoreStore->best(leaderboardMode);
 #ifdef __EMSCRIPTEN__
-    
-    int loadedScore = js_load_high_score();
-    scoreManager->highScore = loadedScore;
-    printf("High score loaded: %d\n", loadedScore);
-#else
-    // 对于非WebAssembly环境，可以从文件加载
-    printf("Loading high score from file (simulated)...\n");
-    // 这里可以添加文件读取逻辑
+    // 兼容旧版本保存在 localStorage 中的最高分
+    int legacyScore = js_load_high_score();
+    if (legacyScore > loadedScore) {
+        loadedScore = legacyScore;
+    }
 #endif
+    if (loadedScore > scoreManager->highScore) {
+        scoreManager->highScore = loadedScore;
+    }
+}
+
+bool GameEngine::openScoreStore(const char* directory) {
+    bool opened = scoreStore->open(directory);
+    loadHighScore();
+    return opened;
+}
+
+ScoreStore& GameEngine::getScoreStore() {
+    return *scoreStore;
+}
+
+void GameEngine::ingestScore(int mode, int score) {
+    scoreStore->ingest(mode, score);
+    if (mode == leaderboardMode && score > scoreManager->highScore) {
+        scoreManager->highScore = score;
+    }
+}
+
+void GameEngine::setLeaderboardMode(int mode) {
+    leaderboardMode = mode;
+    scoreManager->highScore = 0;
+    loadHighScore();
+}
+
+int GameEngine::getLeaderboardMode() const {
+    return leaderboardMode;
 }
 
 float* GameEngine::getFlattenedState() {
     auto dinoState = dino->getState();
-    auto obstacles = obstacleManager->getObstacles();
+    const auto& obstacles = obstacleManager->getObstacles();
     auto scoreState = scoreManager->getState();
 
     // 计算所需数组大小
@@ -223,8 +403,8 @@ float* GameEngine::getFlattenedState() {
     flattenedState[index++] = static_cast<float>(dinoState.height);
     flattenedState[index++] = dinoState.isJumping ? 1.0f : 0.0f;
     flattenedState[index++] = dinoState.isDead ? 1.0f : 0.0f;
-    flattenedState[index++] = groundOffset;
-    flattenedState[index++] = gameSpeed;
+    flattenedState[index++] = toFloat(groundOffset);
+    flattenedState[index++] = toFloat(gameSpeed);
     flattenedState[index++] = static_cast<float>(scoreState.score);
     flattenedState[index++] = static_cast<float>(scoreState.highScore);
     //flattenedState[index++] = static_cast<float>(obstacles.size());
@@ -232,11 +412,11 @@ float* GameEngine::getFlattenedState() {
 
     // 添加障碍物数据
     for (const auto& obs : obstacles) {
-        flattenedState[index++] = obs.x;
+        flattenedState[index++] = toFloat(obs.x);
         flattenedState[index++] = obs.y;
         flattenedState[index++] = static_cast<float>(obs.width);
         flattenedState[index++] = static_cast<float>(obs.height);
-        flattenedState[index++] = (obs.type == "small") ? 1.0f : 0.0f;
+        flattenedState[index++] = static_cast<float>(obs.kind); // ObstacleKind，原型表下标
     }
 
     return flattenedState;
@@ -249,9 +429,11 @@ GameEngine::RenderState GameEngine::getStateForRender() {
     auto dinoState = dino->getState();
     state.dino.x = dinoState.x;
     state.dino.y = dinoState.y;
+    state.dino.yVelocity = dinoState.yVelocity;
     state.dino.width = dinoState.width;
     state.dino.height = dinoState.height;
     state.dino.isJumping = dinoState.isJumping;
+    state.dino.isDucking = dinoState.isDucking;
     state.dino.isDead = dinoState.isDead;
     state.dino.sprite.x = dinoState.sprite.x;
     state.dino.sprite.y = dinoState.sprite.y;
@@ -259,8 +441,8 @@ GameEngine::RenderState GameEngine::getStateForRender() {
     state.dino.sprite.h = dinoState.sprite.h;
     
     state.obstacles = &obstacleManager->getObstacles();
-    state.groundOffset = groundOffset;
-    state.gameSpeed = gameSpeed;
+    state.groundOffset = toFloat(groundOffset);
+    state.gameSpeed = toFloat(gameSpeed);
     
     // 手动复制分数状态
     auto scoreState = scoreManager->getState();
@@ -279,6 +461,66 @@ GameEngine::RenderState GameEngine::getStateForRender() {
     return state;
 }
 
+FrameScheduler& GameEngine::getFrameScheduler() {
+    return *frameScheduler;
+}
+
+EventQueue& GameEngine::getEventQueue() {
+    return *eventQueue;
+}
+
+int GameEngine::getStateBufferBytes() const {
+    return flattenedStateSize * static_cast<int>(sizeof(float)) + renderList->capacityBytes() +
+           static_cast<int>(sizeof(EventRing));
+}
+
+const RenderList& GameEngine::getRenderList() const {
+    return *renderList;
+}
+
+void GameEngine::buildRenderList() {
+    renderList->clear();
+
+    // 地面：两段条带首尾相接实现无缝滚动，每段条带由图集中的若干切片拼成
+    const float groundH = static_cast<float>(GroundConstants::HEIGHT);
+    for (int i = 0; i < 2; i++) {
+        float destX = i * static_cast<float>(GroundConstants::WIDTH) - toFloat(groundOffset);
+        for (int s = 0; s < ATLAS_GROUND_SLICE_COUNT; s++) {
+            const AtlasSprite& slice = ATLAS_GROUND_SLICES[s];
+            const float sliceW = static_cast<float>(slice.w);
+            renderList->push(
+                static_cast<float>(slice.x), static_cast<float>(slice.y),
+                sliceW, groundH,
+                destX, static_cast<float>(GROUND_Y),
+                sliceW, groundH,
+                LAYER_GROUND);
+            destX += sliceW;
+        }
+    }
+
+    // 障碍物：使用生成时选定的精灵变体，有动画的种类按步数轮换帧
+    const int animationStep = tickCount / ObstacleConstants::FRAME_TICKS;
+    for (const auto& obs : obstacleManager->getObstacles()) {
+        const ObstacleConstants::Archetype& archetype = ObstacleConstants::ARCHETYPES[obs.kind];
+        int frameOffset = (animationStep % archetype.FRAMES) * archetype.SPRITE.stride;
+        renderList->push(
+            static_cast<float>(obs.spriteX + frameOffset), static_cast<float>(obs.spriteY),
+            static_cast<float>(obs.width), static_cast<float>(obs.height),
+            toFloat(obs.x), obs.y,
+            static_cast<float>(obs.width), static_cast<float>(obs.height),
+            LAYER_OBSTACLE);
+    }
+
+    // 恐龙：直接使用内核计算的动画帧
+    auto dinoState = dino->getState();
+    renderList->push(
+        static_cast<float>(dinoState.sprite.x), static_cast<float>(dinoState.sprite.y),
+        static_cast<float>(dinoState.sprite.w), static_cast<float>(dinoState.sprite.h),
+        dinoState.x, dinoState.y,
+        static_cast<float>(dinoState.width), static_cast<float>(dinoState.height),
+        LAYER_DINO);
+}
+
 int GameEngine::getScore() const {
     return scoreManager->score;
 }
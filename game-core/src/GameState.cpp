@@ -1,6 +1,12 @@
 #include "GameState.hpp"
 
-GameState::GameState() : state(State::IDLE), lastState(State::IDLE) {}
+GameState::GameState()
+    : onStateChange(nullptr), onStateChangeUserData(nullptr), state(State::IDLE), lastState(State::IDLE) {}
+
+void GameState::setOnStateChange(StateChangeCallback callback, void* userData) {
+    onStateChange = callback;
+    onStateChangeUserData = userData;
+}
 
 GameState::State GameState::setState(State newState) {
     if (state == newState) {
@@ -16,7 +22,7 @@ GameState::State GameState::setState(State newState) {
     
     if (onStateChange) {
         // 模拟JavaScript的setTimeout(..., 0)
-        onStateChange(newState, lastState);
+        onStateChange(onStateChangeUserData, newState, lastState);
     }
     
     return state;
@@ -45,4 +51,13 @@ bool GameState::canTransitionTo(State newState) const {
         default:
             return false;
     }
-}
\ No newline at end of file
+}
+
+GameState::State GameState::get() const {
+    return state;
+}
+
+void GameState::restore(State restored) {
+    lastState = state;
+    state = restored;
+}
@@ -0,0 +1,64 @@
+#include "InputTransport.hpp"
+
+// ============ LoopbackTransport ============
+
+LoopbackTransport::LoopbackTransport() : peer(nullptr), latency(0), frame(0) {}
+
+void LoopbackTransport::connect(LoopbackTransport& a, LoopbackTransport& b) {
+    a.peer = &b;
+    b.peer = &a;
+}
+
+void LoopbackTransport::setLatency(int frames) {
+    latency = frames < 0 ? 0 : frames;
+}
+
+void LoopbackTransport::advance() {
+    frame++;
+}
+
+void LoopbackTransport::send(const InputPacket& packet) {
+    if (!peer) return;
+
+    Pending pending;
+    pending.packet = packet;
+    pending.deliverAt = peer->frame + latency;
+    peer->inbox.push_back(pending);
+}
+
+bool LoopbackTransport::receive(InputPacket& packet) {
+    // 只看队首：延迟变小时后发的包也要排在前面的包之后，保持有序
+    if (inbox.empty() || inbox.front().deliverAt > frame) return false;
+    packet = inbox.front().packet;
+    inbox.pop_front();
+    return true;
+}
+
+// ============ QueueTransport ============
+
+void QueueTransport::send(const InputPacket& packet) {
+    outbox.push_back(packet);
+}
+
+bool QueueTransport::receive(InputPacket& packet) {
+    if (inbox.empty()) return false;
+    packet = inbox.front();
+    inbox.pop_front();
+    return true;
+}
+
+bool QueueTransport::takeOutbound(InputPacket& packet) {
+    if (outbox.empty()) return false;
+    packet = outbox.front();
+    outbox.pop_front();
+    return true;
+}
+
+void QueueTransport::pushInbound(const InputPacket& packet) {
+    inbox.push_back(packet);
+}
+
+void QueueTransport::clear() {
+    outbox.clear();
+    inbox.clear();
+}
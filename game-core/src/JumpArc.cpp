@@ -0,0 +1,187 @@
+#include "JumpArc.hpp"
+#include "Dino.hpp"
+#include "ObstacleManager.hpp"
+#include "constants.hpp"
+
+#include <cmath>
+
+namespace {
+// 预留的余量（步）：跳跃过程中速度可能升一档，且碰撞使用严格不等式
+constexpr float SAFETY_TICKS = 1.0f;
+// 模拟跳跃的步数上限，防止参数异常时死循环
+constexpr int MAX_ARC_TICKS = 1000;
+}
+
+const JumpArc& JumpArc::get() {
+    static const JumpArc arc;
+    return arc;
+}
+
+JumpArc::JumpArc() : airTicks(0), dinoBoxWidth(0), dinoBoxRight(0), duckBoxRight(0) {
+    // 使用真实的 Dino 模拟，修改重力、跳跃力或碰撞盒后表会自动跟随
+    Dino dino;
+    dino.setDucking(true);
+    Dino::BoundingBox duckBox = dino.getBoundingBox();
+    duckBoxRight = toFloat(duckBox.x + duckBox.width);
+    dino.setDucking(false);
+
+    Dino::BoundingBox box = dino.getBoundingBox();
+    float groundBottom = toFloat(box.y + box.height);
+    dinoBoxWidth = toFloat(box.width);
+    dinoBoxRight = toFloat(box.x + box.width);
+
+    // 各种障碍物放在其原型高度上时碰撞盒的上下边缘
+    for (int kind = 0; kind < ObstacleConstants::KIND_COUNT; kind++) {
+        const ObstacleConstants::Archetype& archetype = ObstacleConstants::ARCHETYPES[kind];
+        Obstacle obstacle;
+        obstacle.kind = static_cast<uint8_t>(kind);
+        obstacle.x = 0.0f;
+        obstacle.y = static_cast<float>(GROUND_Y - archetype.ALTITUDE - archetype.SPRITE.h);
+        obstacle.width = archetype.SPRITE.w;
+        obstacle.height = archetype.SPRITE.h;
+        Obstacle::BoundingBox obsBox = obstacle.boundingBox();
+
+        clearances[kind] = groundBottom - toFloat(obsBox.y);
+        headrooms[kind][0] = toFloat(box.y - (obsBox.y + obsBox.height));
+        headrooms[kind][1] = toFloat(duckBox.y - (obsBox.y + obsBox.height));
+    }
+
+    rise.push_back(0.0f);
+    dino.jump();
+    float maxRise = 0.0f;
+    for (int tick = 1; tick <= MAX_ARC_TICKS; tick++) {
+        dino.update(FIXED_STEP_MS);
+        box = dino.getBoundingBox();
+        float height = groundBottom - toFloat(box.y + box.height);
+        rise.push_back(height);
+        if (height > maxRise) maxRise = height;
+        if (!dino.getState().isJumping) {
+            airTicks = tick;
+            break;
+        }
+    }
+
+    // 每个整数离地高度：上升段第一次达到、下降段最后一次离开的时刻（线性插值）
+    int levels = static_cast<int>(std::floor(maxRise)) + 1;
+    int last = static_cast<int>(rise.size()) - 1;
+    windows.resize(levels);
+    for (int r = 0; r < levels; r++) {
+        float level = static_cast<float>(r);
+        Window window = {0.0f, static_cast<float>(last)};
+
+        for (int k = 0; k < last; k++) {
+            if (rise[k] >= level) {
+                window.enter = static_cast<float>(k);
+                break;
+            }
+            if (rise[k + 1] >= level) {
+                window.enter = k + (level - rise[k]) / (rise[k + 1] - rise[k]);
+                break;
+            }
+        }
+        for (int k = last; k > 0; k--) {
+            if (rise[k] >= level) {
+                window.exit = static_cast<float>(k);
+                break;
+            }
+            if (rise[k - 1] >= level) {
+                window.exit = (k - 1) + (rise[k - 1] - level) / (rise[k - 1] - rise[k]);
+                break;
+            }
+        }
+        windows[r] = window;
+    }
+}
+
+int JumpArc::getAirTicks() const {
+    return airTicks;
+}
+
+float JumpArc::clearanceFor(int kind) const {
+    return clearances[kind];
+}
+
+float JumpArc::headroomFor(int kind, bool ducking) const {
+    return headrooms[kind][ducking ? 1 : 0];
+}
+
+float JumpArc::groupSpan(int kind, int count) {
+    const int width = ObstacleConstants::ARCHETYPES[kind].SPRITE.w;
+    Obstacle first;
+    first.kind = static_cast<uint8_t>(kind);
+    first.x = 0.0f;
+    first.y = 0.0f;
+    first.width = width;
+    first.height = 0;
+    Obstacle last = first;
+    last.x = static_cast<float>((count - 1) * width);
+
+    Obstacle::BoundingBox firstBox = first.boundingBox();
+    Obstacle::BoundingBox lastBox = last.boundingBox();
+    return toFloat(lastBox.x + lastBox.width - firstBox.x);
+}
+
+bool JumpArc::clearWindow(float clearance, float& enter, float& exit) const {
+    // 向上取整：所需高度只会被高估，得到的区间偏保守
+    int level = clearance <= 0.0f ? 0 : static_cast<int>(std::ceil(clearance));
+    if (level >= static_cast<int>(windows.size())) {
+        return false;
+    }
+    enter = windows[level].enter;
+    exit = windows[level].exit;
+    return true;
+}
+
+bool JumpArc::canClear(float gap, float span, float clearance, float speed) const {
+    if (clearance <= 0.0f) return true; // 障碍物低于碰撞盒底部，不需要跳
+    if (speed <= 0.0f) return false;
+
+    float enter, exit;
+    if (!clearWindow(clearance, enter, exit)) return false;
+
+    // 障碍物组与恐龙水平重叠的时间段必须完全落在离地足够高的区间内
+    float overlapStart = gap / speed;
+    float overlapEnd = (gap + span + dinoBoxWidth) / speed;
+    return overlapStart >= enter + SAFETY_TICKS && overlapEnd <= exit - SAFETY_TICKS;
+}
+
+bool JumpArc::shouldJump(float gap, float span, float clearance, float speed) const {
+    return canClear(gap, span, clearance, speed) && !canClear(gap - speed, span, clearance, speed);
+}
+
+bool JumpArc::minFollowDistance(float clearance, float nextClearance, float speed, float& distance) const {
+    float enter, exit;
+    float nextEnter, nextExit;
+    if (!clearWindow(clearance, enter, exit) || !clearWindow(nextClearance, nextEnter, nextExit)) {
+        return false;
+    }
+
+    // 最晚起跳时第一组距离约为 (enter + 余量 + 1) 步；落地时下一组仍需至少
+    // (nextEnter + 余量) 步的距离才能再次起跳
+    float ticks = static_cast<float>(airTicks) + 1.0f + nextEnter - enter;
+    distance = ticks * speed;
+    return true;
+}
+
+bool JumpArc::isClearable(float span, float clearance, float speed) const {
+    if (clearance <= 0.0f) return true;
+    if (speed <= 0.0f) return false;
+
+    float enter, exit;
+    if (!clearWindow(clearance, enter, exit)) return false;
+
+    // 起跳只能发生在整步上，最晚起跳时重叠开始于 enter + 余量 之后一步以内
+    return enter + SAFETY_TICKS + 1.0f + (span + dinoBoxWidth) / speed <= exit - SAFETY_TICKS;
+}
+
+float JumpArc::getDinoBoxWidth() const {
+    return dinoBoxWidth;
+}
+
+float JumpArc::getDinoBoxRight() const {
+    return dinoBoxRight;
+}
+
+float JumpArc::getDuckBoxRight() const {
+    return duckBoxRight;
+}
@@ -0,0 +1,79 @@
+#include "MemoryStats.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/heap.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 每个分配块前的头部，记录块大小；保持最大对齐
+constexpr size_t ALLOCATION_HEADER = 16;
+
+std::atomic<size_t> liveBytes(0);
+std::atomic<size_t> peakBytes(0);
+std::atomic<size_t> liveAllocations(0);
+std::atomic<size_t> totalAllocations(0);
+
+void* countedAllocate(size_t size) {
+    unsigned char* block = static_cast<unsigned char*>(std::malloc(size + ALLOCATION_HEADER));
+    if (!block) {
+        std::abort(); // 编译时关闭了异常，无法抛出 std::bad_alloc
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+
+    size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    return block + ALLOCATION_HEADER;
+}
+
+void countedRelease(void* pointer) {
+    if (!pointer) return;
+
+    unsigned char* block = static_cast<unsigned char*>(pointer) - ALLOCATION_HEADER;
+    liveBytes.fetch_sub(*reinterpret_cast<size_t*>(block), std::memory_order_relaxed);
+    liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    std::free(block);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedRelease(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedRelease(pointer);
+}
+
+void readMemoryStats(MemoryStats& stats) {
+    stats.heapHighWater = static_cast<uint32_t>(peakBytes.load(std::memory_order_relaxed));
+    stats.liveBytes = static_cast<uint32_t>(liveBytes.load(std::memory_order_relaxed));
+    stats.liveAllocations = static_cast<uint32_t>(liveAllocations.load(std::memory_order_relaxed));
+    stats.totalAllocations = static_cast<uint32_t>(totalAllocations.load(std::memory_order_relaxed));
+#ifdef __EMSCRIPTEN__
+    stats.linearMemoryBytes = static_cast<uint32_t>(emscripten_get_heap_size());
+    stats.heapTop = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(sbrk(0)));
+#else
+    stats.linearMemoryBytes = 0;
+    stats.heapTop = 0;
+#endif
+}
@@ -0,0 +1,35 @@
+#include "Random.hpp"
+
+Random::Random(uint32_t seedValue) {
+    seed(seedValue);
+}
+
+void Random::seed(uint32_t seedValue) {
+    // 种子先经 splitmix32 打散再作为状态：xorshift 对小种子的前几个输出几乎相同，
+    // 直接使用会让 1、7 这样的相邻种子生成同样的开局。打散是双射，不同种子仍得到不同状态
+    uint32_t z = seedValue + 0x9E3779B9u;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    z ^= z >> 16;
+    // xorshift 的状态不能为 0
+    state = z != 0 ? z : 0x9E3779B9u;
+}
+
+uint32_t Random::next() {
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+}
+
+int Random::nextInt(int bound) {
+    if (bound <= 0) return 0;
+    return static_cast<int>(next() % static_cast<uint32_t>(bound));
+}
+
+float Random::nextFloat() {
+    // 取高 24 位，保证结果可被 float 精确表示
+    return static_cast<float>(next() >> 8) / static_cast<float>(0xFFFFFF);
+}
@@ -0,0 +1,32 @@
+#include "RenderList.hpp"
+
+void RenderList::clear() {
+    // 只重置长度，保留容量，避免每帧重新分配
+    commands.clear();
+}
+
+void RenderList::push(float sx, float sy, float sw, float sh,
+                      float dx, float dy, float dw, float dh,
+                      RenderLayer layer) {
+    commands.push_back(sx);
+    commands.push_back(sy);
+    commands.push_back(sw);
+    commands.push_back(sh);
+    commands.push_back(dx);
+    commands.push_back(dy);
+    commands.push_back(dw);
+    commands.push_back(dh);
+    commands.push_back(static_cast<float>(layer));
+}
+
+const float* RenderList::data() const {
+    return commands.empty() ? nullptr : &commands[0];
+}
+
+int RenderList::count() const {
+    return static_cast<int>(commands.size()) / RENDER_COMMAND_STRIDE;
+}
+
+int RenderList::capacityBytes() const {
+    return static_cast<int>(commands.capacity() * sizeof(float));
+}
@@ -0,0 +1,341 @@
+#include "ReplayArchive.hpp"
+#include "GameEngine.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool readAt(int fd, void* out, size_t size, uint64_t offset) {
+    return ::pread(fd, out, size, static_cast<off_t>(offset)) == static_cast<ssize_t>(size);
+}
+
+uint64_t fileSize(int fd) {
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) return 0;
+    return static_cast<uint64_t>(fileStat.st_size);
+}
+
+uint64_t recordBytes(const ReplayMeta& meta) {
+    return sizeof(ReplayRecordHeader) + static_cast<uint64_t>(meta.inputCount) * sizeof(uint32_t);
+}
+
+// 空文件写入文件头，非空文件校验文件头
+bool prepareFile(int fd, uint32_t magic) {
+    ReplayFileHeader header;
+    if (fileSize(fd) == 0) {
+        header.magic = magic;
+        header.version = REPLAY_VERSION;
+        header.reserved = 0;
+        return writeAll(fd, &header, sizeof(header));
+    }
+    return readAt(fd, &header, sizeof(header), 0) && header.magic == magic && header.version == REPLAY_VERSION;
+}
+
+const unsigned char* mapFile(const char* path, size_t& size) {
+    size = 0;
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    uint64_t bytes = fileSize(fd);
+    if (bytes < sizeof(ReplayFileHeader)) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* memory = mmap(nullptr, static_cast<size_t>(bytes), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // 映射建立后不再需要文件描述符
+    if (memory == MAP_FAILED) return nullptr;
+
+    // 批量校验按序号顺序遍历，让内核提前预读
+    madvise(memory, static_cast<size_t>(bytes), MADV_SEQUENTIAL);
+    size = static_cast<size_t>(bytes);
+    return static_cast<const unsigned char*>(memory);
+}
+
+} // namespace
+
+// ============ ReplayArchiveWriter ============
+
+ReplayArchiveWriter::ReplayArchiveWriter()
+    : dataFd(-1), indexFd(-1), dataBytes(0), recordCount(0), failed(false) {}
+
+ReplayArchiveWriter::~ReplayArchiveWriter() {
+    close();
+}
+
+bool ReplayArchiveWriter::open(const char* directory) {
+    close();
+
+    char path[1024];
+    std::snprintf(path, sizeof(path), "%s/replays.dat", directory);
+    dataFd = ::open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    std::snprintf(path, sizeof(path), "%s/replays.idx", directory);
+    indexFd = ::open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+
+    if (dataFd < 0 || indexFd < 0 || !prepareFile(dataFd, REPLAY_DATA_MAGIC) ||
+        !prepareFile(indexFd, REPLAY_INDEX_MAGIC) || !recoverIndex()) {
+        close();
+        return false;
+    }
+    failed = false;
+    return true;
+}
+
+bool ReplayArchiveWriter::recoverIndex() {
+    uint64_t dataSize = fileSize(dataFd);
+    uint64_t entries = (fileSize(indexFd) - sizeof(ReplayFileHeader)) / sizeof(ReplayIndexEntry);
+
+    // 丢弃指向数据文件之外的索引项（数据写盘前崩溃）
+    dataBytes = sizeof(ReplayFileHeader);
+    while (entries > 0) {
+        ReplayIndexEntry last;
+        if (!readAt(indexFd, &last, sizeof(last),
+                    sizeof(ReplayFileHeader) + (entries - 1) * sizeof(ReplayIndexEntry))) {
+            return false;
+        }
+        uint64_t end = last.offset + recordBytes(last.meta);
+        if (end <= dataSize) {
+            dataBytes = end;
+            break;
+        }
+        entries--;
+    }
+    if (ftruncate(indexFd, static_cast<off_t>(sizeof(ReplayFileHeader) + entries * sizeof(ReplayIndexEntry))) != 0) {
+        return false;
+    }
+
+    // 索引之后的完整记录补进索引（索引写盘前崩溃），不完整的尾部截掉
+    std::vector<ReplayIndexEntry> missing;
+    ReplayRecordHeader header;
+    while (dataBytes + sizeof(header) <= dataSize && readAt(dataFd, &header, sizeof(header), dataBytes) &&
+           header.magic == REPLAY_RECORD_MAGIC && dataBytes + recordBytes(header.meta) <= dataSize) {
+        ReplayIndexEntry entry;
+        entry.offset = dataBytes;
+        entry.meta = header.meta;
+        missing.push_back(entry);
+        dataBytes += recordBytes(header.meta);
+    }
+    if (dataBytes < dataSize && ftruncate(dataFd, static_cast<off_t>(dataBytes)) != 0) {
+        return false;
+    }
+    if (!missing.empty() &&
+        (!writeAll(indexFd, &missing[0], missing.size() * sizeof(ReplayIndexEntry)) || fsync(indexFd) != 0)) {
+        return false;
+    }
+
+    recordCount = entries + missing.size();
+    return true;
+}
+
+void ReplayArchiveWriter::close() {
+    if (dataFd >= 0 && indexFd >= 0) {
+        flush();
+    }
+    if (dataFd >= 0) {
+        ::close(dataFd);
+        dataFd = -1;
+    }
+    if (indexFd >= 0) {
+        ::close(indexFd);
+        indexFd = -1;
+    }
+    pendingData.clear();
+    pendingIndex.clear();
+    dataBytes = 0;
+    recordCount = 0;
+}
+
+void ReplayArchiveWriter::append(const ReplayMeta& meta, const uint32_t* inputs) {
+    if (dataFd < 0) return;
+
+    ReplayRecordHeader header;
+    header.magic = REPLAY_RECORD_MAGIC;
+    header.reserved = 0;
+    header.meta = meta;
+
+    const unsigned char* headerBytes = reinterpret_cast<const unsigned char*>(&header);
+    const unsigned char* inputBytes = reinterpret_cast<const unsigned char*>(inputs);
+    pendingData.insert(pendingData.end(), headerBytes, headerBytes + sizeof(header));
+    pendingData.insert(pendingData.end(), inputBytes, inputBytes + meta.inputCount * sizeof(uint32_t));
+
+    ReplayIndexEntry entry;
+    entry.offset = dataBytes;
+    entry.meta = meta;
+    pendingIndex.push_back(entry);
+
+    dataBytes += recordBytes(meta);
+    recordCount++;
+    if (pendingIndex.size() >= REPLAY_FLUSH_BATCH) {
+        flush();
+    }
+}
+
+bool ReplayArchiveWriter::flush() {
+    if (dataFd < 0 || failed) return !failed;
+    if (pendingIndex.empty()) return true;
+
+    // 先让数据落盘再写索引，索引项永远不会指向不存在的数据
+    bool ok = writeAll(dataFd, &pendingData[0], pendingData.size()) && fsync(dataFd) == 0 &&
+              writeAll(indexFd, &pendingIndex[0], pendingIndex.size() * sizeof(ReplayIndexEntry)) &&
+              fsync(indexFd) == 0;
+    pendingData.clear();
+    pendingIndex.clear();
+    if (!ok) {
+        failed = true; // 磁盘写满等：之后的记录全部丢弃，下次打开时截掉不完整的尾部
+    }
+    return ok;
+}
+
+uint64_t ReplayArchiveWriter::getRecordCount() const {
+    return recordCount;
+}
+
+// ============ ReplayArchive ============
+
+ReplayArchive::ReplayArchive()
+    : data(nullptr), dataSize(0), indexData(nullptr), indexSize(0), entries(nullptr), entryCount(0) {}
+
+ReplayArchive::~ReplayArchive() {
+    close();
+}
+
+bool ReplayArchive::open(const char* directory) {
+    close();
+
+    char path[1024];
+    std::snprintf(path, sizeof(path), "%s/replays.dat", directory);
+    data = mapFile(path, dataSize);
+    std::snprintf(path, sizeof(path), "%s/replays.idx", directory);
+    indexData = mapFile(path, indexSize);
+    if (!data || !indexData) {
+        close();
+        return false;
+    }
+
+    const ReplayFileHeader* dataHeader = reinterpret_cast<const ReplayFileHeader*>(data);
+    const ReplayFileHeader* indexHeader = reinterpret_cast<const ReplayFileHeader*>(indexData);
+    if (dataHeader->magic != REPLAY_DATA_MAGIC || dataHeader->version != REPLAY_VERSION ||
+        indexHeader->magic != REPLAY_INDEX_MAGIC || indexHeader->version != REPLAY_VERSION) {
+        close();
+        return false;
+    }
+
+    // 索引项按偏移递增，只需从尾部去掉越过数据文件末尾的项（写入端正在写或崩溃）
+    entries = reinterpret_cast<const ReplayIndexEntry*>(indexData + sizeof(ReplayFileHeader));
+    entryCount = (indexSize - sizeof(ReplayFileHeader)) / sizeof(ReplayIndexEntry);
+    while (entryCount > 0 &&
+           entries[entryCount - 1].offset + recordBytes(entries[entryCount - 1].meta) > dataSize) {
+        entryCount--;
+    }
+    return true;
+}
+
+void ReplayArchive::close() {
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), dataSize);
+        data = nullptr;
+    }
+    if (indexData) {
+        munmap(const_cast<unsigned char*>(indexData), indexSize);
+        indexData = nullptr;
+    }
+    dataSize = 0;
+    indexSize = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+size_t ReplayArchive::count() const {
+    return entryCount;
+}
+
+const ReplayIndexEntry& ReplayArchive::entry(size_t index) const {
+    return entries[index];
+}
+
+const uint32_t* ReplayArchive::inputs(size_t index) const {
+    const ReplayIndexEntry& indexEntry = entries[index];
+    const ReplayRecordHeader* header = reinterpret_cast<const ReplayRecordHeader*>(data + indexEntry.offset);
+    // 记录头与索引不一致说明文件损坏，按没有数据处理
+    if (header->magic != REPLAY_RECORD_MAGIC || header->meta.inputCount != indexEntry.meta.inputCount) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint32_t*>(header + 1);
+}
+
+// ============ 校验 ============
+
+const char* replayStatusName(ReplayStatus status) {
+    switch (status) {
+        case REPLAY_OK: return "ok";
+        case REPLAY_MALFORMED: return "malformed";
+        case REPLAY_ENDED_EARLY: return "ended_early";
+        case REPLAY_NOT_ENDED: return "not_ended";
+        case REPLAY_SCORE_MISMATCH: return "score_mismatch";
+        default: return "unknown";
+    }
+}
+
+ReplayVerdict verifyReplay(GameEngine& engine, const ReplayMeta& meta, const uint32_t* inputs) {
+    ReplayVerdict verdict;
+    verdict.status = REPLAY_MALFORMED;
+    verdict.ticks = 0;
+    verdict.score = 0;
+
+    // 先检查输入本身，模拟循环里就不用再判断
+    if (meta.claimedTicks > REPLAY_MAX_TICKS || (meta.inputCount > 0 && !inputs)) return verdict;
+    for (uint32_t i = 0; i < meta.inputCount; i++) {
+        if (replayInputTick(inputs[i]) >= meta.claimedTicks || replayInputAction(inputs[i]) > REPLAY_DUCK_RELEASE ||
+            (i > 0 && replayInputTick(inputs[i]) < replayInputTick(inputs[i - 1]))) {
+            return verdict;
+        }
+    }
+
+    engine.setSeed(meta.seed);
+    engine.reset();
+    engine.start();
+
+    uint32_t next = 0;
+    int ticks = 0;
+    while (ticks < static_cast<int>(meta.claimedTicks)) {
+        for (; next < meta.inputCount && replayInputTick(inputs[next]) == static_cast<uint32_t>(ticks); next++) {
+            switch (replayInputAction(inputs[next])) {
+                case REPLAY_JUMP: engine.jump(); break;
+                case REPLAY_DUCK_PRESS: engine.duck(true); break;
+                default: engine.duck(false); break;
+            }
+        }
+        engine.tick();
+        if (engine.getTickCount() == ticks) break; // 上一步已经撞上
+        ticks = engine.getTickCount();
+    }
+
+    bool ended = engine.getStateForRender().gameState == 2;
+    verdict.ticks = ticks;
+    verdict.score = engine.getScore();
+    if (!ended) {
+        verdict.status = REPLAY_NOT_ENDED;
+    } else if (ticks < static_cast<int>(meta.claimedTicks)) {
+        verdict.status = REPLAY_ENDED_EARLY;
+    } else if (verdict.score != meta.claimedScore) {
+        verdict.status = REPLAY_SCORE_MISMATCH;
+    } else {
+        verdict.status = REPLAY_OK;
+    }
+    return verdict;
+}
@@ -0,0 +1,298 @@
+#include "ScoreStore.hpp"
+
+#include <cstring>
+#include <ctime>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+
+// 异步写入 IndexedDB，不等待完成
+EM_JS(void, js_score_store_append, (int mode, int score, int timestamp), {
+    if (typeof indexedDB === 'undefined') return;
+    if (!globalThis.__dinoScoreDb) {
+        globalThis.__dinoScoreDb = new Promise(function (resolve, reject) {
+            const request = indexedDB.open('dino_scores', 1);
+            request.onupgradeneeded = function () {
+                request.result.createObjectStore('scores', { autoIncrement: true });
+            };
+            request.onsuccess = function () { resolve(request.result); };
+            request.onerror = function () { reject(request.error); };
+        });
+    }
+    globalThis.__dinoScoreDb.then(function (db) {
+        db.transaction('scores', 'readwrite').objectStore('scores')
+            .add({ mode: mode, score: score, timestamp: timestamp });
+    }).catch(function (error) {
+        console.warn('保存分数失败:', error);
+    });
+});
+#else
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr uint32_t INDEX_MAGIC = 0x44534331; // "DSC1"
+constexpr uint32_t INDEX_VERSION = 2;
+}
+
+ScoreStore::ScoreStore() : index(nullptr), mapped(false), logFd(-1), indexFd(-1) {
+    index = new LeaderboardIndex();
+    resetIndex();
+}
+
+ScoreStore::~ScoreStore() {
+    close();
+    if (!mapped) {
+        delete index;
+    }
+}
+
+void ScoreStore::resetIndex() {
+    std::memset(index, 0, sizeof(LeaderboardIndex));
+    index->magic = INDEX_MAGIC;
+    index->version = INDEX_VERSION;
+}
+
+int ScoreStore::clampMode(int mode) {
+    if (mode < 0) return 0;
+    if (mode >= LEADERBOARD_MODES) return LEADERBOARD_MODES - 1;
+    return mode;
+}
+
+bool ScoreStore::open(const char* directory) {
+#ifdef __EMSCRIPTEN__
+    (void)directory;
+    return true;
+#else
+    close();
+
+    char path[1024];
+    std::snprintf(path, sizeof(path), "%s/scores.log", directory);
+    logFd = ::open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (logFd < 0) return false;
+
+    std::snprintf(path, sizeof(path), "%s/scores.idx", directory);
+    indexFd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (indexFd < 0 || ftruncate(indexFd, sizeof(LeaderboardIndex)) != 0) {
+        close();
+        return false;
+    }
+
+    void* memory = mmap(nullptr, sizeof(LeaderboardIndex), PROT_READ | PROT_WRITE, MAP_SHARED, indexFd, 0);
+    if (memory == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    // 以映射的文件替换内存中的索引
+    delete index;
+    index = static_cast<LeaderboardIndex*>(memory);
+    mapped = true;
+
+    // 写入中途崩溃会在日志末尾留下不完整的记录：截掉它，否则之后追加的记录都会错位
+    struct stat logStat;
+    if (fstat(logFd, &logStat) != 0) {
+        close();
+        return false;
+    }
+    uint64_t logRecords = static_cast<uint64_t>(logStat.st_size) / sizeof(ScoreRecord);
+    if (static_cast<uint64_t>(logStat.st_size) != logRecords * sizeof(ScoreRecord) &&
+        ftruncate(logFd, static_cast<off_t>(logRecords * sizeof(ScoreRecord))) != 0) {
+        close();
+        return false;
+    }
+
+    // 索引无效、与日志长度不一致，或含有未落盘的记录（写盘前崩溃）时从日志重建
+    if (index->magic != INDEX_MAGIC || index->version != INDEX_VERSION || index->indexedRecords != logRecords ||
+        index->unflushedRecords != 0) {
+        return rebuildFromLog();
+    }
+    return true;
+#endif
+}
+
+void ScoreStore::close() {
+#ifndef __EMSCRIPTEN__
+    flush();
+
+    if (mapped) {
+        // 回到堆内存中的索引副本，关闭后查询仍然可用
+        LeaderboardIndex* copy = new LeaderboardIndex(*index);
+        munmap(index, sizeof(LeaderboardIndex));
+        index = copy;
+        mapped = false;
+    }
+    if (indexFd >= 0) {
+        ::close(indexFd);
+        indexFd = -1;
+    }
+    if (logFd >= 0) {
+        ::close(logFd);
+        logFd = -1;
+    }
+#endif
+}
+
+void ScoreStore::record(int mode, int score) {
+    mode = clampMode(mode);
+    uint32_t timestamp = static_cast<uint32_t>(std::time(nullptr));
+
+#ifdef __EMSCRIPTEN__
+    applyToIndex(mode, score);
+    js_score_store_append(mode, score, static_cast<int>(timestamp));
+#else
+    if (logFd < 0) { // 未打开存储：只保留在内存中
+        applyToIndex(mode, score);
+        index->indexedRecords++;
+        return;
+    }
+
+    // 先在映射的索引中记下未落盘的记录再修改索引：之后任何时刻崩溃，下次打开都会从日志重建
+    index->unflushedRecords++;
+    applyToIndex(mode, score);
+
+    ScoreRecord entry;
+    entry.mode = static_cast<uint32_t>(mode);
+    entry.score = score;
+    entry.timestamp = timestamp;
+    entry.reserved = 0;
+    pending.push_back(entry);
+
+    if (static_cast<int>(pending.size()) >= SCORE_FLUSH_BATCH) {
+        flush();
+    }
+#endif
+}
+
+void ScoreStore::ingest(int mode, int score) {
+    applyToIndex(clampMode(mode), score);
+    index->indexedRecords++;
+}
+
+void ScoreStore::flush() {
+#ifndef __EMSCRIPTEN__
+    if (logFd < 0 || pending.empty()) return;
+
+    const char* data = reinterpret_cast<const char*>(&pending[0]);
+    size_t total = pending.size() * sizeof(ScoreRecord);
+    size_t remaining = total;
+    while (remaining > 0) {
+        ssize_t written = ::write(logFd, data, remaining);
+        if (written <= 0) break;
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    if (remaining > 0) {
+        // 写入失败（磁盘写满等）：截掉写了一半的记录，保持日志按记录对齐
+        // 截断也失败时停止写日志（只保留在内存中），避免之后的记录错位
+        struct stat logStat;
+        if (fstat(logFd, &logStat) != 0 ||
+            ftruncate(logFd, logStat.st_size - logStat.st_size % static_cast<off_t>(sizeof(ScoreRecord))) != 0) {
+            ::close(logFd);
+            logFd = -1;
+            pending.clear();
+            return;
+        }
+    }
+
+    // 只有 fsync 成功的记录才从 unflushedRecords 转入 indexedRecords。
+    // 没写进日志（或 fsync 失败）的记录仍计在 unflushedRecords 中：本次运行内照常可查，下次打开时从日志重建丢掉它们
+    if (fsync(logFd) == 0) {
+        uint64_t written = (total - remaining) / sizeof(ScoreRecord);
+        index->indexedRecords += written;
+        index->unflushedRecords -= written;
+    }
+    pending.clear();
+
+    if (mapped) {
+        msync(index, sizeof(LeaderboardIndex), MS_ASYNC);
+    }
+#endif
+}
+
+void ScoreStore::applyToIndex(int mode, int score) {
+    LeaderboardIndex::Mode& board = index->modes[mode];
+    board.count++;
+
+    int bucket = (score < 0 ? 0 : score) / SCORE_BUCKET_WIDTH;
+    if (bucket >= SCORE_HISTOGRAM_BUCKETS) bucket = SCORE_HISTOGRAM_BUCKETS - 1;
+    board.histogram[bucket]++;
+
+    // 插入降序的 top-K 数组
+    if (board.topCount == LEADERBOARD_TOP_K && score <= board.top[LEADERBOARD_TOP_K - 1]) {
+        return;
+    }
+    int position = board.topCount < LEADERBOARD_TOP_K ? board.topCount : LEADERBOARD_TOP_K - 1;
+    while (position > 0 && board.top[position - 1] < score) {
+        board.top[position] = board.top[position - 1];
+        position--;
+    }
+    board.top[position] = score;
+    if (board.topCount < LEADERBOARD_TOP_K) {
+        board.topCount++;
+    }
+}
+
+bool ScoreStore::rebuildFromLog() {
+#ifdef __EMSCRIPTEN__
+    return true;
+#else
+    resetIndex();
+
+    // 顺序读取整个日志，每次读取一批记录
+    ScoreRecord buffer[1024];
+    off_t offset = 0;
+    for (;;) {
+        ssize_t bytes = pread(logFd, buffer, sizeof(buffer), offset);
+        if (bytes <= 0) break;
+        size_t records = static_cast<size_t>(bytes) / sizeof(ScoreRecord);
+        if (records == 0) break;
+        for (size_t i = 0; i < records; i++) {
+            applyToIndex(clampMode(static_cast<int>(buffer[i].mode)), buffer[i].score);
+        }
+        index->indexedRecords += records;
+        offset += static_cast<off_t>(records * sizeof(ScoreRecord));
+    }
+
+    msync(index, sizeof(LeaderboardIndex), MS_SYNC);
+    return true;
+#endif
+}
+
+int ScoreStore::best(int mode) const {
+    const LeaderboardIndex::Mode& board = index->modes[clampMode(mode)];
+    return board.topCount > 0 ? board.top[0] : 0;
+}
+
+int ScoreStore::topCount(int mode) const {
+    return index->modes[clampMode(mode)].topCount;
+}
+
+const int32_t* ScoreStore::top(int mode) const {
+    return index->modes[clampMode(mode)].top;
+}
+
+uint32_t ScoreStore::count(int mode) const {
+    return index->modes[clampMode(mode)].count;
+}
+
+float ScoreStore::percentile(int mode, int score) const {
+    const LeaderboardIndex::Mode& board = index->modes[clampMode(mode)];
+    if (board.count == 0) return 0.0f;
+
+    int bucket = (score < 0 ? 0 : score) / SCORE_BUCKET_WIDTH;
+    if (bucket >= SCORE_HISTOGRAM_BUCKETS) bucket = SCORE_HISTOGRAM_BUCKETS - 1;
+
+    // 直方图前缀和：固定 4096 次加法，与记录数量无关
+    uint64_t below = 0;
+    for (int i = 0; i < bucket; i++) {
+        below += board.histogram[i];
+    }
+    // 同一桶内的记录按一半计入
+    double ranked = static_cast<double>(below) + board.histogram[bucket] * 0.5;
+    return static_cast<float>(ranked * 100.0 / board.count);
+}
@@ -0,0 +1,337 @@
+#include "TrajectoryDataset.hpp"
+#include "GameEngine.hpp"
+#include "ObstacleManager.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const uint32_t TRAJECTORY_COLUMN_SIZES[TRAJ_COLUMN_COUNT] = {
+    4, // TRAJ_EPISODE
+    4, // TRAJ_TICK
+    4, // TRAJ_DINO_Y
+    4, // TRAJ_DINO_VELOCITY
+    1, // TRAJ_JUMPING
+    1, // TRAJ_DUCKING
+    4, // TRAJ_OBSTACLE_DX
+    4, // TRAJ_OBSTACLE_WIDTH
+    4, // TRAJ_OBSTACLE_HEIGHT
+    1, // TRAJ_OBSTACLE_KIND
+    4, // TRAJ_OBSTACLE_BOTTOM
+    4, // TRAJ_NEXT_DX
+    4, // TRAJ_GAME_SPEED
+    4, // TRAJ_SCORE
+    1, // TRAJ_DONE
+};
+
+namespace {
+
+size_t alignColumn(size_t bytes) {
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+TrajectoryRow makeTrajectoryRow(GameEngine& engine, uint32_t episode, uint32_t tick) {
+    GameEngine::RenderState state = engine.getStateForRender();
+
+    TrajectoryRow row;
+    row.episode = episode;
+    row.tick = tick;
+    row.dinoY = state.dino.y;
+    row.dinoVelocity = state.dino.yVelocity;
+    row.jumping = state.dino.isJumping ? 1 : 0;
+    row.ducking = state.dino.isDucking ? 1 : 0;
+    row.obstacleDx = -1.0f;
+    row.obstacleWidth = 0.0f;
+    row.obstacleHeight = 0.0f;
+    row.obstacleKind = 255;
+    row.obstacleBottom = 0.0f;
+    row.nextDx = -1.0f;
+    row.gameSpeed = state.gameSpeed;
+    row.score = state.score.score;
+    row.done = state.gameState == 2 ? 1 : 0;
+
+    // 障碍物按 x 升序排列，取前两个还没有完全越过恐龙的
+    float dinoRight = state.dino.x + state.dino.width;
+    int found = 0;
+    for (const auto& obs : *state.obstacles) {
+        float obsX = toFloat(obs.x);
+        if (obsX + obs.width <= state.dino.x) continue;
+
+        if (found == 0) {
+            row.obstacleDx = obsX - dinoRight;
+            row.obstacleWidth = static_cast<float>(obs.width);
+            row.obstacleHeight = static_cast<float>(obs.height);
+            row.obstacleKind = obs.kind;
+            row.obstacleBottom = obs.y + static_cast<float>(obs.height);
+        } else {
+            row.nextDx = obsX - dinoRight;
+            break;
+        }
+        found++;
+    }
+    return row;
+}
+
+// ============ TrajectoryWriter ============
+
+TrajectoryWriter::TrajectoryWriter()
+    : fd(-1), activeBuffer(0), pendingBuffer(-1), stopping(false), failed(false),
+      rowsWritten(0), stallCount(0) {
+    for (int b = 0; b < 2; b++) {
+        buffers[b].rows = 0;
+    }
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    close();
+}
+
+bool TrajectoryWriter::open(const char* path) {
+    close();
+
+    fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    TrajectoryFileHeader header;
+    header.magic = TRAJECTORY_FILE_MAGIC;
+    header.version = TRAJECTORY_VERSION;
+    header.columnCount = TRAJ_COLUMN_COUNT;
+    header.chunkRows = TRAJECTORY_CHUNK_ROWS;
+    if (!writeAll(fd, &header, sizeof(header))) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    for (int b = 0; b < 2; b++) {
+        buffers[b].rows = 0;
+        for (int c = 0; c < TRAJ_COLUMN_COUNT; c++) {
+            buffers[b].columns[c].resize(static_cast<size_t>(TRAJECTORY_CHUNK_ROWS) * TRAJECTORY_COLUMN_SIZES[c]);
+        }
+    }
+    activeBuffer = 0;
+    pendingBuffer = -1;
+    stopping = false;
+    failed = false;
+    rowsWritten = 0;
+    stallCount = 0;
+
+    ioThread = std::thread(&TrajectoryWriter::ioLoop, this);
+    return true;
+}
+
+void TrajectoryWriter::append(const TrajectoryRow& row) {
+    if (fd < 0) return;
+
+    ChunkBuffer& buffer = buffers[activeBuffer];
+    uint32_t r = buffer.rows;
+
+#define DINO_TRAJ_PUT(column, value) \
+    std::memcpy(&buffer.columns[column][static_cast<size_t>(r) * TRAJECTORY_COLUMN_SIZES[column]], \
+                &(value), TRAJECTORY_COLUMN_SIZES[column])
+    DINO_TRAJ_PUT(TRAJ_EPISODE, row.episode);
+    DINO_TRAJ_PUT(TRAJ_TICK, row.tick);
+    DINO_TRAJ_PUT(TRAJ_DINO_Y, row.dinoY);
+    DINO_TRAJ_PUT(TRAJ_DINO_VELOCITY, row.dinoVelocity);
+    DINO_TRAJ_PUT(TRAJ_JUMPING, row.jumping);
+    DINO_TRAJ_PUT(TRAJ_DUCKING, row.ducking);
+    DINO_TRAJ_PUT(TRAJ_OBSTACLE_DX, row.obstacleDx);
+    DINO_TRAJ_PUT(TRAJ_OBSTACLE_WIDTH, row.obstacleWidth);
+    DINO_TRAJ_PUT(TRAJ_OBSTACLE_HEIGHT, row.obstacleHeight);
+    DINO_TRAJ_PUT(TRAJ_OBSTACLE_KIND, row.obstacleKind);
+    DINO_TRAJ_PUT(TRAJ_OBSTACLE_BOTTOM, row.obstacleBottom);
+    DINO_TRAJ_PUT(TRAJ_NEXT_DX, row.nextDx);
+    DINO_TRAJ_PUT(TRAJ_GAME_SPEED, row.gameSpeed);
+    DINO_TRAJ_PUT(TRAJ_SCORE, row.score);
+    DINO_TRAJ_PUT(TRAJ_DONE, row.done);
+#undef DINO_TRAJ_PUT
+
+    buffer.rows++;
+    if (buffer.rows == TRAJECTORY_CHUNK_ROWS) {
+        submitActive();
+    }
+}
+
+void TrajectoryWriter::submitActive() {
+    std::unique_lock<std::mutex> lock(mutex);
+    // 另一块缓冲还没写完：只能等待（磁盘跟不上模拟）
+    if (pendingBuffer != -1) {
+        stallCount++;
+        wake.wait(lock, [this] { return pendingBuffer == -1; });
+    }
+    pendingBuffer = activeBuffer;
+    activeBuffer = 1 - activeBuffer;
+    buffers[activeBuffer].rows = 0;
+    wake.notify_all();
+}
+
+void TrajectoryWriter::ioLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return pendingBuffer != -1 || stopping; });
+        if (pendingBuffer == -1) break; // stopping 且没有待写的缓冲
+
+        // 写盘期间不持有锁，模拟线程可以继续填充另一块缓冲
+        const ChunkBuffer& buffer = buffers[pendingBuffer];
+        lock.unlock();
+        bool written = writeChunk(buffer);
+        lock.lock();
+
+        if (written) {
+            rowsWritten += buffer.rows;
+        }
+        pendingBuffer = -1;
+        wake.notify_all();
+    }
+}
+
+bool TrajectoryWriter::writeChunk(const ChunkBuffer& buffer) {
+    if (failed || buffer.rows == 0) return false;
+
+    TrajectoryChunkHeader header;
+    header.magic = TRAJECTORY_CHUNK_MAGIC;
+    header.rows = buffer.rows;
+    header.bytes = sizeof(header);
+    for (int c = 0; c < TRAJ_COLUMN_COUNT; c++) {
+        header.bytes += alignColumn(static_cast<size_t>(buffer.rows) * TRAJECTORY_COLUMN_SIZES[c]);
+    }
+
+    static const unsigned char padding[8] = {0};
+    bool ok = writeAll(fd, &header, sizeof(header));
+    for (int c = 0; ok && c < TRAJ_COLUMN_COUNT; c++) {
+        size_t bytes = static_cast<size_t>(buffer.rows) * TRAJECTORY_COLUMN_SIZES[c];
+        ok = writeAll(fd, &buffer.columns[c][0], bytes) &&
+             writeAll(fd, padding, alignColumn(bytes) - bytes);
+    }
+    if (!ok) {
+        failed = true; // 磁盘写满等：之后的块全部丢弃，已写出的完整块仍然可读
+    }
+    return ok;
+}
+
+bool TrajectoryWriter::close() {
+    if (fd < 0) return !failed;
+
+    if (buffers[activeBuffer].rows > 0) {
+        submitActive();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    ioThread.join();
+
+    if (::close(fd) != 0) {
+        failed = true;
+    }
+    fd = -1;
+    return !failed;
+}
+
+bool TrajectoryWriter::hasFailed() const {
+    return failed;
+}
+
+uint64_t TrajectoryWriter::getRowsWritten() const {
+    return rowsWritten;
+}
+
+uint64_t TrajectoryWriter::getStallCount() const {
+    return stallCount;
+}
+
+// ============ TrajectoryReader ============
+
+TrajectoryReader::TrajectoryReader() : data(nullptr), size(0), rows(0) {}
+
+TrajectoryReader::~TrajectoryReader() {
+    close();
+}
+
+bool TrajectoryReader::open(const char* path) {
+    close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < sizeof(TrajectoryFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+
+    void* memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // 映射建立后不再需要文件描述符
+    if (memory == MAP_FAILED) {
+        size = 0;
+        return false;
+    }
+    data = static_cast<const unsigned char*>(memory);
+    madvise(memory, size, MADV_SEQUENTIAL);
+
+    const TrajectoryFileHeader* header = reinterpret_cast<const TrajectoryFileHeader*>(data);
+    if (header->magic != TRAJECTORY_FILE_MAGIC || header->version != TRAJECTORY_VERSION ||
+        header->columnCount != TRAJ_COLUMN_COUNT) {
+        close();
+        return false;
+    }
+
+    // 顺序扫描块头建立索引；末尾不完整的块（写入中途崩溃）直接忽略
+    size_t offset = sizeof(TrajectoryFileHeader);
+    while (offset + sizeof(TrajectoryChunkHeader) <= size) {
+        const TrajectoryChunkHeader* chunkHeader = reinterpret_cast<const TrajectoryChunkHeader*>(data + offset);
+        if (chunkHeader->magic != TRAJECTORY_CHUNK_MAGIC || chunkHeader->bytes > size - offset) break;
+
+        Chunk entry;
+        entry.rows = chunkHeader->rows;
+        size_t columnOffset = offset + sizeof(TrajectoryChunkHeader);
+        for (int c = 0; c < TRAJ_COLUMN_COUNT; c++) {
+            entry.columns[c] = data + columnOffset;
+            columnOffset += alignColumn(static_cast<size_t>(entry.rows) * TRAJECTORY_COLUMN_SIZES[c]);
+        }
+        if (columnOffset - offset != chunkHeader->bytes) break; // 块头损坏
+        chunks.push_back(entry);
+        rows += entry.rows;
+        offset += chunkHeader->bytes;
+    }
+    return true;
+}
+
+void TrajectoryReader::close() {
+    if (data) {
+        munmap(const_cast<unsigned char*>(data), size);
+        data = nullptr;
+    }
+    size = 0;
+    chunks.clear();
+    rows = 0;
+}
+
+size_t TrajectoryReader::chunkCount() const {
+    return chunks.size();
+}
+
+const TrajectoryReader::Chunk& TrajectoryReader::chunk(size_t index) const {
+    return chunks[index];
+}
+
+uint64_t TrajectoryReader::rowCount() const {
+    return rows;
+}
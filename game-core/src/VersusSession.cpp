@@ -0,0 +1,249 @@
+#include "VersusSession.hpp"
+#include "EngineSnapshot.hpp"
+#include "GameEngine.hpp"
+#include "InputTransport.hpp"
+
+#include <chrono>
+
+namespace {
+constexpr int SNAPSHOT_SLOTS = VERSUS_MAX_ROLLBACK + 1;
+constexpr size_t TRIM_THRESHOLD = 64; // 已消费的对手输入累计到这么多时才整理一次
+}
+
+VersusSession::VersusSession()
+    : local(nullptr), transport(nullptr), lastSentTick(-1), remoteCursor(0), remoteConfirmed(0),
+      stats(), active(false) {
+    remote = new GameEngine();
+    remote->setScoreRecording(false);
+    snapshots = new EngineSnapshot[SNAPSHOT_SLOTS];
+}
+
+VersusSession::~VersusSession() {
+    delete remote;
+    delete[] snapshots;
+}
+
+void VersusSession::start(GameEngine* localEngine, InputTransport* inputTransport, uint32_t seed) {
+    local = localEngine;
+    transport = inputTransport;
+
+    // 本地自动游玩的操作发生在引擎内部，无法记录成输入
+    local->setAutoplay(false);
+    local->setSeed(seed);
+    local->reset();
+    local->start();
+    remote->setSeed(seed);
+    remote->reset();
+    remote->start();
+
+    outbound.clear();
+    lastSentTick = -1;
+    remoteInputs.clear();
+    remoteCursor = 0;
+    remoteConfirmed = 0;
+    stats = Stats();
+    active = true;
+}
+
+void VersusSession::stop() {
+    active = false;
+    transport = nullptr;
+}
+
+bool VersusSession::isActive() const {
+    return active;
+}
+
+void VersusSession::update(float currentTime) {
+    if (!active) return;
+
+    local->update(currentTime);
+    sendInputs();
+    receiveInputs();
+
+    // 对手最多预测到本地当前的步数，且不超过已确认步数之后 VERSUS_MAX_ROLLBACK 步；
+    // 本地结束后不再需要预测，只按确认的输入推进
+    int target = remoteConfirmed;
+    if (isLocalPlaying() && !isRemoteFinished()) {
+        int localTick = local->getTickCount();
+        target = remoteConfirmed + VERSUS_MAX_ROLLBACK;
+        if (localTick > target) {
+            stats.stalledFrames++;
+        } else {
+            target = localTick;
+        }
+    }
+    advanceRemote(target);
+}
+
+bool VersusSession::jump() {
+    if (!active) return false;
+    // 被拒绝的起跳（空中、下蹲中）对双方都没有效果，不用发送
+    if (local->jump()) {
+        recordLocalInput(REPLAY_JUMP);
+        return true;
+    }
+    return false;
+}
+
+void VersusSession::duck(bool held) {
+    if (!active) return;
+    bool playing = isLocalPlaying();
+    local->duck(held);
+    if (playing) {
+        recordLocalInput(held ? REPLAY_DUCK_PRESS : REPLAY_DUCK_RELEASE);
+    }
+}
+
+void VersusSession::recordLocalInput(ReplayAction action) {
+    outbound.push_back(encodeReplayInput(static_cast<uint32_t>(local->getTickCount()), action));
+}
+
+void VersusSession::sendInputs() {
+    int tick = local->getTickCount();
+    if (outbound.empty() && tick == lastSentTick) return;
+
+    // 一帧的输入超过一个包时分多个包发送；非最后一个包只确认到下一个未发出输入的步数
+    size_t next = 0;
+    do {
+        InputPacket packet;
+        packet.count = 0;
+        while (next < outbound.size() && packet.count < static_cast<uint32_t>(VERSUS_PACKET_INPUTS)) {
+            packet.inputs[packet.count++] = outbound[next++];
+        }
+        packet.confirmedTick = next < outbound.size() ? replayInputTick(outbound[next]) : static_cast<uint32_t>(tick);
+        transport->send(packet);
+    } while (next < outbound.size());
+
+    outbound.clear();
+    lastSentTick = tick;
+}
+
+void VersusSession::receiveInputs() {
+    InputPacket packet;
+    int earliest = -1;
+    while (transport->receive(packet)) {
+        uint32_t count = packet.count;
+        if (count > static_cast<uint32_t>(VERSUS_PACKET_INPUTS)) count = VERSUS_PACKET_INPUTS;
+
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t input = packet.inputs[i];
+            int tick = static_cast<int>(replayInputTick(input));
+            // 新输入不能早于已确认的步数，且必须按 tick 升序，否则无法回滚到位
+            if (tick < remoteConfirmed || replayInputAction(input) > REPLAY_DUCK_RELEASE ||
+                (!remoteInputs.empty() && replayInputTick(input) < replayInputTick(remoteInputs.back()))) {
+                stats.rejectedInputs++;
+                continue;
+            }
+            remoteInputs.push_back(input);
+            if (earliest < 0 || tick < earliest) earliest = tick;
+        }
+        if (static_cast<int>(packet.confirmedTick) > remoteConfirmed) {
+            remoteConfirmed = static_cast<int>(packet.confirmedTick);
+        }
+    }
+
+    // 输入落在已经预测过的步数上：预测错了，回滚重算
+    if (earliest >= 0 && earliest < remote->getTickCount()) {
+        rollbackTo(earliest);
+    }
+}
+
+void VersusSession::rollbackTo(int tick) {
+    auto begin = std::chrono::steady_clock::now();
+
+    // 快照在预测该步之前保存；预测不超过确认步数之后 VERSUS_MAX_ROLLBACK 步，
+    // 且新输入不早于确认步数，所以目标快照一定还在环形缓冲中
+    int predictedTick = remote->getTickCount();
+    remote->loadSnapshot(snapshots[tick % SNAPSHOT_SLOTS]);
+    while (remoteCursor > 0 && static_cast<int>(replayInputTick(remoteInputs[remoteCursor - 1])) >= tick) {
+        remoteCursor--;
+    }
+    while (remote->getTickCount() < predictedTick && simulateRemoteTick()) {
+    }
+
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    int depth = predictedTick - tick;
+    stats.rollbacks++;
+    stats.resimulatedTicks += depth;
+    if (depth > stats.maxRollbackDepth) stats.maxRollbackDepth = depth;
+    stats.lastRollbackMs = elapsed.count();
+    if (elapsed.count() > stats.maxRollbackMs) stats.maxRollbackMs = elapsed.count();
+}
+
+bool VersusSession::simulateRemoteTick() {
+    int tick = remote->getTickCount();
+    // 只有预测的步数之后可能被回滚
+    if (tick >= remoteConfirmed) {
+        remote->saveSnapshot(snapshots[tick % SNAPSHOT_SLOTS]);
+    }
+
+    for (; remoteCursor < remoteInputs.size() &&
+           static_cast<int>(replayInputTick(remoteInputs[remoteCursor])) <= tick;
+         remoteCursor++) {
+        switch (replayInputAction(remoteInputs[remoteCursor])) {
+            case REPLAY_JUMP: remote->jump(); break;
+            case REPLAY_DUCK_PRESS: remote->duck(true); break;
+            default: remote->duck(false); break;
+        }
+    }
+
+    remote->tick();
+    return remote->getTickCount() != tick;
+}
+
+void VersusSession::advanceRemote(int targetTick) {
+    while (remote->getTickCount() < targetTick && simulateRemoteTick()) {
+    }
+
+    // 早于确认步数且已施加的输入不会再被回滚用到
+    size_t consumed = 0;
+    while (consumed < remoteCursor && static_cast<int>(replayInputTick(remoteInputs[consumed])) < remoteConfirmed) {
+        consumed++;
+    }
+    if (consumed >= TRIM_THRESHOLD) {
+        remoteInputs.erase(remoteInputs.begin(), remoteInputs.begin() + static_cast<std::ptrdiff_t>(consumed));
+        remoteCursor -= consumed;
+    }
+}
+
+bool VersusSession::isLocalPlaying() const {
+    return local->getStateForRender().gameState == 1;
+}
+
+bool VersusSession::isRemoteFinished() const {
+    return remote->getStateForRender().gameState == 2 && remote->getTickCount() <= remoteConfirmed;
+}
+
+GameEngine& VersusSession::getRemote() {
+    return *remote;
+}
+
+int VersusSession::getRemoteConfirmedTick() const {
+    return remoteConfirmed;
+}
+
+VersusOutcome VersusSession::getOutcome() const {
+    if (!local) return VERSUS_PENDING;
+
+    bool localDone = local->getStateForRender().gameState == 2;
+    bool remoteDone = isRemoteFinished();
+    // 对手状态在确认步数之内时才是确定的
+    bool remoteCertain = remote->getTickCount() <= remoteConfirmed;
+    int localScore = local->getScore();
+    int remoteScore = remote->getScore();
+
+    if (localDone && remoteDone) {
+        if (localScore > remoteScore) return VERSUS_WIN;
+        if (localScore < remoteScore) return VERSUS_LOSE;
+        return VERSUS_DRAW;
+    }
+    // 分数只增不减：先结束的一方已经被超过时结果就确定了
+    if (localDone && remoteCertain && remoteScore > localScore) return VERSUS_LOSE;
+    if (remoteDone && localScore > remoteScore) return VERSUS_WIN;
+    return VERSUS_PENDING;
+}
+
+const VersusSession::Stats& VersusSession::getStats() const {
+    return stats;
+}
@@ -6,6 +6,7 @@ constexpr DinoConstants::Sprite DinoConstants::RUN_1;
 constexpr DinoConstants::Sprite DinoConstants::RUN_2;
 constexpr DinoConstants::Sprite DinoConstants::JUMP;
 constexpr DinoConstants::Sprite DinoConstants::DEAD;
+constexpr DinoConstants::Sprite DinoConstants::DUCK_1;
+constexpr DinoConstants::Sprite DinoConstants::DUCK_2;
 
-constexpr ObstacleConstants::Config ObstacleConstants::SMALL;
-constexpr ObstacleConstants::Config ObstacleConstants::BIG;
\ No newline at end of file
+constexpr ObstacleConstants::Archetype ObstacleConstants::ARCHETYPES[];
\ No newline at end of file
@@ -0,0 +1,189 @@
+// 本地排行榜工具（原生）：查看或写入指定目录中的 ScoreStore，并测量大量记录下的写入与查询耗时。
+//
+// 用法:
+//   leaderboard_tool 目录 add 模式 分数
+//   leaderboard_tool 目录 top 模式 [N]
+//   leaderboard_tool 目录 pct 模式 分数
+//   leaderboard_tool 目录 bench [记录数]
+//   leaderboard_tool 目录 crashtest
+//
+// crashtest 在子进程中记录分数后模拟崩溃（不 flush 直接退出）和写盘失败（文件大小受限导致短写），
+// 再重新打开，检查索引与日志逐条重算的结果一致：没有落盘的分数不能留在索引里
+
+#include "ScoreStore.hpp"
+#include "Random.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point begin) {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count();
+}
+
+int usage(const char* program) {
+    std::fprintf(stderr,
+                 "用法: %s 目录 add 模式 分数\n"
+                 "      %s 目录 top 模式 [N]\n"
+                 "      %s 目录 pct 模式 分数\n"
+                 "      %s 目录 bench [记录数]\n"
+                 "      %s 目录 crashtest\n",
+                 program, program, program, program, program);
+    return 2;
+}
+
+int runBench(ScoreStore& store, int records) {
+    Random random(12345);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < records; i++) {
+        // 近似真实分布：大多数局分数较低
+        int score = static_cast<int>(random.nextFloat() * random.nextFloat() * 3000.0f);
+        store.record(i % LEADERBOARD_MODES, score);
+    }
+    store.flush();
+    double writeMs = elapsedMs(begin);
+
+    const int queries = 100000;
+    volatile float sink = 0;
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        sink = sink + store.percentile(i % LEADERBOARD_MODES, random.nextInt(3000));
+    }
+    double queryMs = elapsedMs(begin);
+
+    std::printf("records=%d write=%.1fms (%.3fus/record)\n", records, writeMs, writeMs * 1000.0 / records);
+    std::printf("percentile queries=%d total=%.1fms (%.3fus/query)\n", queries, queryMs, queryMs * 1000.0 / queries);
+    for (int mode = 0; mode < LEADERBOARD_MODES; mode++) {
+        std::printf("mode %d: count=%u best=%d\n", mode, store.count(mode), store.best(mode));
+    }
+    return 0;
+}
+
+// 直接读取日志逐条统计，与索引比对；不一致时输出差异并返回 false
+bool matchesLog(const ScoreStore& store, const char* directory, const char* phase) {
+    char path[1024];
+    std::snprintf(path, sizeof(path), "%s/scores.log", directory);
+    uint32_t counts[LEADERBOARD_MODES] = {};
+    int bests[LEADERBOARD_MODES] = {};
+    FILE* log = std::fopen(path, "rb");
+    if (log) {
+        ScoreRecord entry;
+        while (std::fread(&entry, sizeof(entry), 1, log) == 1) {
+            int mode = entry.mode < LEADERBOARD_MODES ? static_cast<int>(entry.mode) : LEADERBOARD_MODES - 1;
+            if (counts[mode] == 0 || entry.score > bests[mode]) bests[mode] = entry.score;
+            counts[mode]++;
+        }
+        std::fclose(log);
+    }
+
+    bool ok = true;
+    for (int mode = 0; mode < LEADERBOARD_MODES; mode++) {
+        if (store.count(mode) != counts[mode] || store.best(mode) != bests[mode]) {
+            std::printf("%s: mode %d index count=%u best=%d, log count=%u best=%d\n", phase, mode,
+                        store.count(mode), store.best(mode), counts[mode], bests[mode]);
+            ok = false;
+        }
+    }
+    std::printf("%s: %s\n", phase, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+// 在子进程中打开目录并执行 body，返回子进程是否正常退出
+template <typename Body>
+bool inChild(const char* directory, Body body) {
+    pid_t child = fork();
+    if (child < 0) return false;
+    if (child == 0) {
+        ScoreStore victim;
+        if (!victim.open(directory)) _exit(1);
+        body(victim);
+        _exit(0); // 不执行析构：模拟崩溃，未 flush 的记录不会落盘
+    }
+    int status = 0;
+    return waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int runCrashTest(ScoreStore& store, const char* directory) {
+    store.close();
+    int best = store.best(0);
+
+    // 1. 记录不足一批（不会自动 flush）后直接退出
+    bool ok = inChild(directory, [best](ScoreStore& victim) {
+        for (int i = 0; i < SCORE_FLUSH_BATCH / 2; i++) {
+            victim.record(i % LEADERBOARD_MODES, best + 1000 + i);
+        }
+    });
+    ok = ok && store.open(directory) && matchesLog(store, directory, "crash before flush");
+    store.close();
+
+    // 2. 日志只能再写下不到两条记录：flush 短写，之后正常关闭
+    char path[1024];
+    std::snprintf(path, sizeof(path), "%s/scores.log", directory);
+    struct stat logStat;
+    off_t logSize = stat(path, &logStat) == 0 ? logStat.st_size : 0;
+    ok = inChild(directory, [logSize, best](ScoreStore& victim) {
+        signal(SIGXFSZ, SIG_IGN); // 超过限制时 write 返回短写而不是终止进程
+        struct rlimit limit;
+        limit.rlim_cur = limit.rlim_max = static_cast<rlim_t>(logSize) + sizeof(ScoreRecord) * 3 / 2;
+        setrlimit(RLIMIT_FSIZE, &limit);
+        for (int i = 0; i < SCORE_FLUSH_BATCH; i++) {
+            victim.record(i % LEADERBOARD_MODES, best + 2000 + i);
+        }
+        victim.close();
+    }) && ok;
+    ok = ok && store.open(directory) && matchesLog(store, directory, "short write");
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) return usage(argv[0]);
+
+    ScoreStore store;
+    if (!store.open(argv[1])) {
+        std::fprintf(stderr, "无法打开排行榜目录: %s\n", argv[1]);
+        return 1;
+    }
+
+    const char* command = argv[2];
+    if (std::strcmp(command, "add") == 0 && argc == 5) {
+        store.record(std::atoi(argv[3]), std::atoi(argv[4]));
+        store.flush();
+        return 0;
+    }
+    if (std::strcmp(command, "top") == 0 && (argc == 4 || argc == 5)) {
+        int mode = std::atoi(argv[3]);
+        int limit = argc == 5 ? std::atoi(argv[4]) : 10;
+        int count = store.topCount(mode);
+        const int32_t* top = store.top(mode);
+        for (int i = 0; i < count && i < limit; i++) {
+            std::printf("%3d. %d\n", i + 1, top[i]);
+        }
+        return 0;
+    }
+    if (std::strcmp(command, "pct") == 0 && argc == 5) {
+        int mode = std::atoi(argv[3]);
+        int score = std::atoi(argv[4]);
+        std::printf("%.2f%% of %u records are below %d\n", store.percentile(mode, score), store.count(mode), score);
+        return 0;
+    }
+    if (std::strcmp(command, "bench") == 0 && (argc == 3 || argc == 4)) {
+        return runBench(store, argc == 4 ? std::atoi(argv[3]) : 1000000);
+    }
+    if (std::strcmp(command, "crashtest") == 0 && argc == 3) {
+        return runCrashTest(store, argv[1]);
+    }
+    return usage(argv[0]);
+}
@@ -0,0 +1,264 @@
+// 回归基准：在固定种子上回放固定输入脚本，逐步哈希内核状态并与黄金文件比对，
+// 同时记录每个场景的耗时。优化 Dino / ObstacleManager / CollisionSystem 时，
+// 校验和必须保持不变，否则即为行为变化，需要确认后使用 --update-golden 重新生成黄金文件。
+// 黄金文件中没有的场景（NEW）同样算作失败，避免新增场景在未记录黄金值时静默通过。
+//
+// 用法: regression_bench [--golden 文件] [--update-golden] [--repeat N] [--csv 文件]
+
+#include "GameEngine.hpp"
+#include "ObstacleManager.hpp"
+#include "Random.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifndef DINO_BENCH_GOLDEN
+#define DINO_BENCH_GOLDEN "bench/golden.txt"
+#endif
+
+namespace {
+
+constexpr int MAX_TICKS = 20000; // 单局上限（约 5.5 分钟游戏时间）
+
+enum InputScript {
+    SCRIPT_IDLE,   // 从不跳跃
+    SCRIPT_SPAM,   // 每一步都尝试跳跃（落地立刻起跳）
+    SCRIPT_RANDOM, // 以固定种子随机跳跃
+    SCRIPT_AUTO    // 内置自动游玩（按跳跃轨迹表起跳）
+};
+
+struct Scenario {
+    std::string name;
+    uint32_t seed;
+    InputScript script;
+};
+
+struct RunResult {
+    int ticks;
+    int score;
+    uint64_t checksum;
+};
+
+struct GoldenEntry {
+    int ticks;
+    int score;
+    uint64_t checksum;
+};
+
+// FNV-1a 64 位
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+void hashFloat(uint64_t& hash, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hashBytes(hash, &bits, sizeof(bits));
+}
+
+void hashInt(uint64_t& hash, int value) {
+    int32_t v = static_cast<int32_t>(value);
+    hashBytes(hash, &v, sizeof(v));
+}
+
+bool wantsJump(InputScript script, Random& inputRandom) {
+    switch (script) {
+        case SCRIPT_SPAM:
+            return true;
+        case SCRIPT_RANDOM:
+            return inputRandom.nextInt(25) == 0;
+        case SCRIPT_AUTO:
+        case SCRIPT_IDLE:
+        default:
+            return false;
+    }
+}
+
+RunResult runScenario(const Scenario& scenario) {
+    GameEngine engine;
+    engine.setSeed(scenario.seed);
+    engine.setAutoplay(scenario.script == SCRIPT_AUTO);
+    engine.reset();
+    engine.start();
+
+    Random inputRandom(scenario.seed ^ 0xA5A5A5A5u);
+    uint64_t hash = 14695981039346656037ULL;
+
+    while (engine.getTickCount() < MAX_TICKS) {
+        if (wantsJump(scenario.script, inputRandom)) {
+            engine.jump();
+        }
+        engine.tick();
+
+        auto state = engine.getStateForRender();
+        hashFloat(hash, state.dino.y);
+        hashInt(hash, state.score.score);
+        hashInt(hash, static_cast<int>(state.obstacles->size()));
+        for (const auto& obs : *state.obstacles) {
+            hashFloat(hash, toFloat(obs.x));
+        }
+
+        if (state.gameState != 1) break;
+    }
+
+    RunResult result;
+    result.ticks = engine.getTickCount();
+    result.score = engine.getScore();
+    result.checksum = hash;
+    return result;
+}
+
+std::vector<Scenario> buildScenarios() {
+    const uint32_t seeds[] = {1, 7, 42, 1234};
+    const struct {
+        const char* name;
+        InputScript script;
+    } scripts[] = {
+        {"idle", SCRIPT_IDLE},
+        {"spam", SCRIPT_SPAM},
+        {"random", SCRIPT_RANDOM},
+        {"auto", SCRIPT_AUTO},
+    };
+
+    std::vector<Scenario> scenarios;
+    for (uint32_t seed : seeds) {
+        for (const auto& script : scripts) {
+            Scenario scenario;
+            scenario.name = std::string(script.name) + "/" + std::to_string(seed);
+            scenario.seed = seed;
+            scenario.script = script.script;
+            scenarios.push_back(scenario);
+        }
+    }
+    return scenarios;
+}
+
+std::map<std::string, GoldenEntry> loadGolden(const char* path) {
+    std::map<std::string, GoldenEntry> golden;
+    FILE* file = std::fopen(path, "r");
+    if (!file) return golden;
+
+    char name[128];
+    GoldenEntry entry;
+    unsigned long long checksum;
+    while (std::fscanf(file, "%127s %d %d %llx", name, &entry.ticks, &entry.score, &checksum) == 4) {
+        entry.checksum = checksum;
+        golden[name] = entry;
+    }
+    std::fclose(file);
+    return golden;
+}
+
+bool saveGolden(const char* path, const std::vector<Scenario>& scenarios, const std::vector<RunResult>& results) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+
+    for (size_t i = 0; i < scenarios.size(); i++) {
+        std::fprintf(file, "%s %d %d %016llx\n", scenarios[i].name.c_str(), results[i].ticks,
+                     results[i].score, static_cast<unsigned long long>(results[i].checksum));
+    }
+    std::fclose(file);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* goldenPath = DINO_BENCH_GOLDEN;
+    const char* csvPath = nullptr;
+    bool update = false;
+    int repeat = 5;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            goldenPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--update-golden") == 0) {
+            update = true;
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::atoi(argv[++i]);
+            if (repeat < 1) repeat = 1;
+        } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "用法: %s [--golden 文件] [--update-golden] [--repeat N] [--csv 文件]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    auto scenarios = buildScenarios();
+    auto golden = loadGolden(goldenPath);
+    std::vector<RunResult> results;
+
+    FILE* csv = csvPath ? std::fopen(csvPath, "a") : nullptr;
+    int changed = 0;
+    int added = 0;
+    double totalMs = 0;
+
+    for (const auto& scenario : scenarios) {
+        RunResult result = {0, 0, 0};
+        double bestMs = 0;
+        double sumMs = 0;
+
+        for (int r = 0; r < repeat; r++) {
+            auto begin = std::chrono::steady_clock::now();
+            result = runScenario(scenario);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+            double ms = elapsed.count();
+            sumMs += ms;
+            if (r == 0 || ms < bestMs) bestMs = ms;
+        }
+        results.push_back(result);
+        totalMs += bestMs;
+
+        const char* status = "NEW";
+        auto it = golden.find(scenario.name);
+        if (it == golden.end()) {
+            added++;
+        } else {
+            bool same = it->second.checksum == result.checksum &&
+                        it->second.ticks == result.ticks &&
+                        it->second.score == result.score;
+            status = same ? "OK" : "CHANGED";
+            if (!same) changed++;
+        }
+
+        std::printf("%-12s ticks=%6d score=%5d checksum=%016llx best=%8.3fms mean=%8.3fms  %s\n",
+                    scenario.name.c_str(), result.ticks, result.score,
+                    static_cast<unsigned long long>(result.checksum), bestMs, sumMs / repeat, status);
+
+        if (csv) {
+            std::fprintf(csv, "%s,%d,%d,%016llx,%.4f,%.4f\n", scenario.name.c_str(), result.ticks,
+                         result.score, static_cast<unsigned long long>(result.checksum), bestMs, sumMs / repeat);
+        }
+    }
+
+    if (csv) std::fclose(csv);
+    std::printf("total best time: %.3fms\n", totalMs);
+
+    if (update) {
+        if (!saveGolden(goldenPath, scenarios, results)) {
+            std::fprintf(stderr, "无法写入黄金文件: %s\n", goldenPath);
+            return 2;
+        }
+        std::printf("golden updated: %s\n", goldenPath);
+        return 0;
+    }
+
+    if (changed > 0) {
+        std::printf("%d scenario(s) changed behaviour (checksum mismatch)\n", changed);
+    }
+    if (added > 0) {
+        std::printf("%d scenario(s) missing from golden file, record them with --update-golden\n", added);
+    }
+    return changed > 0 || added > 0 ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+// 回放批量校验：mmap 打开回放存档（见 ReplayArchive.hpp），多个线程各用一个 headless 引擎
+// 按种子与输入重新模拟每条记录，与声称的步数和分数比对，不一致的记录写入报告（TSV）。
+// --generate 用自动游玩生成测试存档，其中按比例篡改一部分记录，便于检查校验与测量吞吐。
+//
+// 用法: replay_verify <存档目录> [--threads N] [--report 文件] [--since 时间戳] [--until 时间戳]
+//       replay_verify <存档目录> --generate 局数 [--seed 起始种子] [--tamper 百分比]
+
+#include "EventQueue.hpp"
+#include "GameEngine.hpp"
+#include "Random.hpp"
+#include "ReplayArchive.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_TICKS = 20000; // 生成时单局上限，与回归基准一致
+constexpr size_t VERIFY_BATCH = 256; // 线程每次领取的记录数
+
+struct Mismatch {
+    size_t index;
+    ReplayVerdict verdict;
+};
+
+struct WorkerResult {
+    std::vector<Mismatch> mismatches;
+    uint64_t verified;
+    uint64_t ticks;
+};
+
+// 用自动游玩玩一局并记录等效的输入：跳跃来自 EVENT_JUMP，下蹲来自姿态变化。
+// 随机步数后关闭自动游玩，让恐龙撞上下一个障碍物，得到一局正常结束的记录
+bool recordRun(GameEngine& pilot, uint32_t seed, Random& random, std::vector<uint32_t>& inputs, ReplayMeta& meta) {
+    inputs.clear();
+    pilot.setSeed(seed);
+    pilot.setAutoplay(true);
+    pilot.reset();
+    pilot.start();
+
+    EngineEvent event;
+    while (pilot.getEventQueue().pop(event)) {
+    }
+
+    int budget = 300 + random.nextInt(6000);
+    bool ducking = false;
+    while (pilot.getTickCount() < MAX_TICKS) {
+        if (pilot.getTickCount() == budget) {
+            pilot.setAutoplay(false);
+        }
+
+        uint32_t tick = static_cast<uint32_t>(pilot.getTickCount());
+        pilot.tick();
+        while (pilot.getEventQueue().pop(event)) {
+            if (event.type == EVENT_JUMP) {
+                inputs.push_back(encodeReplayInput(static_cast<uint32_t>(event.tick - 1), REPLAY_JUMP));
+            }
+        }
+
+        GameEngine::RenderState state = pilot.getStateForRender();
+        if (state.gameState != 1) break;
+        if (state.dino.isDucking != ducking) {
+            ducking = state.dino.isDucking;
+            inputs.push_back(encodeReplayInput(tick, ducking ? REPLAY_DUCK_PRESS : REPLAY_DUCK_RELEASE));
+        }
+    }
+    if (pilot.getStateForRender().gameState != 2) return false;
+
+    meta.seed = seed;
+    meta.claimedScore = pilot.getScore();
+    meta.claimedTicks = static_cast<uint32_t>(pilot.getTickCount());
+    meta.inputCount = static_cast<uint32_t>(inputs.size());
+    return true;
+}
+
+int generate(const char* directory, int count, uint32_t baseSeed, int tamperPercent) {
+    ReplayArchiveWriter writer;
+    if (!writer.open(directory)) {
+        std::fprintf(stderr, "无法打开存档: %s\n", directory);
+        return 1;
+    }
+
+    GameEngine pilot;
+    Random random(baseSeed ^ 0x5EED5EEDu);
+    std::vector<uint32_t> inputs;
+    uint64_t ticks = 0;
+    int written = 0;
+    int tampered = 0;
+    uint32_t now = static_cast<uint32_t>(std::time(nullptr));
+
+    for (int i = 0; i < count; i++) {
+        ReplayMeta meta;
+        if (!recordRun(pilot, baseSeed + static_cast<uint32_t>(i), random, inputs, meta)) continue;
+        meta.playerId = static_cast<uint32_t>(random.nextInt(100000));
+        meta.submittedAt = now - static_cast<uint32_t>(count - i);
+        ticks += meta.claimedTicks;
+
+        // 篡改：虚报分数、谎报步数或删掉最后一次跳跃
+        if (random.nextInt(100) < tamperPercent) {
+            switch (tampered % 3) {
+                case 0: meta.claimedScore += 1 + random.nextInt(500); break;
+                case 1: meta.claimedTicks += 1 + random.nextInt(60); break;
+                default:
+                    for (size_t k = inputs.size(); k-- > 0;) {
+                        if (replayInputAction(inputs[k]) == REPLAY_JUMP) {
+                            inputs.erase(inputs.begin() + static_cast<std::ptrdiff_t>(k));
+                            break;
+                        }
+                    }
+                    meta.inputCount = static_cast<uint32_t>(inputs.size());
+                    break;
+            }
+            tampered++;
+        }
+        writer.append(meta, inputs.empty() ? nullptr : &inputs[0]);
+        written++;
+    }
+
+    bool ok = writer.flush();
+    std::printf("%s: appended=%d tampered=%d ticks=%llu total records=%llu\n", directory, written, tampered,
+                static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(writer.getRecordCount()));
+    writer.close();
+    return ok ? 0 : 1;
+}
+
+void verifyWorker(const ReplayArchive* archive, const std::vector<size_t>* selection, std::atomic<size_t>* cursor,
+                  WorkerResult* result) {
+    GameEngine engine;
+    engine.setAutoplay(false);
+    result->verified = 0;
+    result->ticks = 0;
+
+    for (;;) {
+        size_t begin = cursor->fetch_add(VERIFY_BATCH);
+        if (begin >= selection->size()) break;
+        size_t end = std::min(begin + VERIFY_BATCH, selection->size());
+
+        for (size_t s = begin; s < end; s++) {
+            size_t index = (*selection)[s];
+            ReplayVerdict verdict = verifyReplay(engine, archive->entry(index).meta, archive->inputs(index));
+            result->verified++;
+            result->ticks += static_cast<uint64_t>(verdict.ticks);
+            if (verdict.status != REPLAY_OK) {
+                Mismatch mismatch;
+                mismatch.index = index;
+                mismatch.verdict = verdict;
+                result->mismatches.push_back(mismatch);
+            }
+        }
+    }
+}
+
+bool compareMismatch(const Mismatch& a, const Mismatch& b) {
+    return a.index < b.index;
+}
+
+int verify(const char* directory, int threads, const char* reportPath, uint32_t since, uint32_t until) {
+    ReplayArchive archive;
+    if (!archive.open(directory)) {
+        std::fprintf(stderr, "无法读取存档: %s\n", directory);
+        return 1;
+    }
+
+    // 按提交时间筛选只读索引，不会触及数据文件
+    std::vector<size_t> selection;
+    selection.reserve(archive.count());
+    for (size_t i = 0; i < archive.count(); i++) {
+        uint32_t submittedAt = archive.entry(i).meta.submittedAt;
+        if (submittedAt >= since && submittedAt <= until) {
+            selection.push_back(i);
+        }
+    }
+
+    std::atomic<size_t> cursor(0);
+    std::vector<WorkerResult> results(threads);
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(std::thread(verifyWorker, &archive, &selection, &cursor, &results[t]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    std::vector<Mismatch> mismatches;
+    uint64_t totalTicks = 0;
+    int statusCounts[REPLAY_SCORE_MISMATCH + 1] = {0};
+    for (const auto& result : results) {
+        mismatches.insert(mismatches.end(), result.mismatches.begin(), result.mismatches.end());
+        totalTicks += result.ticks;
+    }
+    std::sort(mismatches.begin(), mismatches.end(), compareMismatch);
+
+    FILE* report = reportPath ? std::fopen(reportPath, "w") : nullptr;
+    if (reportPath && !report) {
+        std::fprintf(stderr, "无法写入报告: %s\n", reportPath);
+        return 1;
+    }
+    if (report) {
+        std::fprintf(report, "index\tseed\tplayer\tsubmitted_at\tstatus\tclaimed_ticks\tticks\tclaimed_score\tscore\n");
+    }
+    for (const auto& mismatch : mismatches) {
+        statusCounts[mismatch.verdict.status]++;
+        if (!report) continue;
+        const ReplayMeta& meta = archive.entry(mismatch.index).meta;
+        std::fprintf(report, "%zu\t%u\t%u\t%u\t%s\t%u\t%d\t%d\t%d\n", mismatch.index, meta.seed, meta.playerId,
+                     meta.submittedAt, replayStatusName(mismatch.verdict.status), meta.claimedTicks,
+                     mismatch.verdict.ticks, meta.claimedScore, mismatch.verdict.score);
+    }
+    if (report) {
+        std::fclose(report);
+    }
+
+    std::printf("threads=%d replays=%zu ticks=%llu time=%.2fs (%.0f replays/s, %.1fM ticks/s) mismatches=%zu",
+                threads, selection.size(), static_cast<unsigned long long>(totalTicks), elapsed.count(),
+                selection.size() / elapsed.count(), totalTicks / elapsed.count() / 1e6, mismatches.size());
+    for (int s = REPLAY_MALFORMED; s <= REPLAY_SCORE_MISMATCH; s++) {
+        if (statusCounts[s]) std::printf(" %s=%d", replayStatusName(static_cast<ReplayStatus>(s)), statusCounts[s]);
+    }
+    std::printf("\n");
+    return mismatches.empty() ? 0 : 3;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        std::fprintf(stderr, "用法: %s <存档目录> [--threads N] [--report 文件] [--since 时间戳] [--until 时间戳]\n"
+                             "      %s <存档目录> --generate 局数 [--seed 起始种子] [--tamper 百分比]\n",
+                     argv[0], argv[0]);
+        return 2;
+    }
+    const char* directory = argv[1];
+
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    const char* reportPath = nullptr;
+    uint32_t since = 0;
+    uint32_t until = UINT32_MAX;
+    int generateCount = 0;
+    uint32_t baseSeed = 1;
+    int tamperPercent = 0;
+
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+            if (threads < 1) threads = 1;
+        } else if (std::strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            reportPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--since") == 0 && i + 1 < argc) {
+            since = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--until") == 0 && i + 1 < argc) {
+            until = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            generateCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            baseSeed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--tamper") == 0 && i + 1 < argc) {
+            tamperPercent = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (generateCount > 0) {
+        return generate(directory, generateCount, baseSeed, tamperPercent);
+    }
+    return verify(directory, threads, reportPath, since, until);
+}
@@ -0,0 +1,194 @@
+// 轨迹导出：多个线程并行运行 headless 对局，每个线程把逐步状态写入自己的列式数据集文件
+// （见 TrajectoryDataset.hpp）。--inspect 使用只读接口读取文件并输出汇总，作为读取示例。
+//
+// 默认使用随机策略（随机起跳、按下/松开下蹲），覆盖不同的起跳与下蹲时机；
+// --autoplay 改用内核的自动游玩，对局能跑到出现鸟的速度，数据中包含自动游玩的跳跃与下蹲。
+//
+// 用法: trajectory_export [--out 目录] [--threads N] [--episodes 每线程局数] [--seed 起始种子] [--autoplay]
+//       trajectory_export --inspect 文件
+
+#include "GameEngine.hpp"
+#include "Random.hpp"
+#include "TrajectoryDataset.hpp"
+#include "constants.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_TICKS = 20000; // 单局上限，与回归基准一致
+
+struct ShardResult {
+    uint64_t rows;
+    uint64_t stalls;
+    bool ok;
+};
+
+void runShard(const char* directory, int shard, int episodes, uint32_t baseSeed, bool autoplay, ShardResult* result) {
+    char path[1024];
+    std::snprintf(path, sizeof(path), "%s/shard-%02d.dtrj", directory, shard);
+
+    TrajectoryWriter writer;
+    result->ok = writer.open(path);
+    if (!result->ok) return;
+
+    GameEngine engine;
+    engine.setAutoplay(autoplay);
+    for (int e = 0; e < episodes; e++) {
+        uint32_t episode = static_cast<uint32_t>(shard * episodes + e);
+        uint32_t seed = baseSeed + episode;
+        engine.setSeed(seed);
+        engine.reset();
+        engine.start();
+
+        // 随机策略：随机起跳，偶尔按下或松开下蹲
+        Random inputRandom(seed ^ 0xA5A5A5A5u);
+        bool duckHeld = false;
+        while (engine.getTickCount() < MAX_TICKS) {
+            if (!autoplay) {
+                if (inputRandom.nextInt(25) == 0) {
+                    engine.jump();
+                }
+                if (inputRandom.nextInt(40) == 0) {
+                    duckHeld = !duckHeld;
+                    engine.duck(duckHeld);
+                }
+            }
+            engine.tick();
+
+            TrajectoryRow row = makeTrajectoryRow(engine, episode, static_cast<uint32_t>(engine.getTickCount()));
+            writer.append(row);
+            if (row.done) break;
+        }
+    }
+
+    result->ok = writer.close();
+    result->rows = writer.getRowsWritten();
+    result->stalls = writer.getStallCount();
+}
+
+int inspect(const char* path) {
+    TrajectoryReader reader;
+    if (!reader.open(path)) {
+        std::fprintf(stderr, "无法读取数据集: %s\n", path);
+        return 1;
+    }
+
+    // 只访问需要的列：数据直接来自映射内存
+    uint64_t episodes = 0; // 按局编号计数，达到步数上限的局没有 done 行
+    uint64_t finished = 0;
+    uint32_t lastEpisode = 0;
+    uint64_t jumpingRows = 0;
+    uint64_t duckingRows = 0;
+    uint64_t kindRows[ObstacleConstants::KIND_COUNT] = {};
+    int64_t finalScoreSum = 0;
+    for (size_t c = 0; c < reader.chunkCount(); c++) {
+        uint32_t rows = reader.chunk(c).rows;
+        const uint32_t* episode = reader.column<uint32_t>(c, TRAJ_EPISODE);
+        const uint8_t* done = reader.column<uint8_t>(c, TRAJ_DONE);
+        const uint8_t* jumping = reader.column<uint8_t>(c, TRAJ_JUMPING);
+        const uint8_t* ducking = reader.column<uint8_t>(c, TRAJ_DUCKING);
+        const uint8_t* kind = reader.column<uint8_t>(c, TRAJ_OBSTACLE_KIND);
+        const int32_t* score = reader.column<int32_t>(c, TRAJ_SCORE);
+        for (uint32_t r = 0; r < rows; r++) {
+            jumpingRows += jumping[r];
+            duckingRows += ducking[r];
+            if (kind[r] < ObstacleConstants::KIND_COUNT) kindRows[kind[r]]++;
+            if (episodes == 0 || episode[r] != lastEpisode) {
+                episodes++;
+                lastEpisode = episode[r];
+            }
+            if (done[r]) {
+                finished++;
+                finalScoreSum += score[r];
+            }
+        }
+    }
+
+    double rowCount = static_cast<double>(reader.rowCount());
+    std::printf("%s: chunks=%zu rows=%llu episodes=%llu finished=%llu airborne=%.1f%% ducking=%.1f%% "
+                "mean final score=%.1f\n", path,
+                reader.chunkCount(), static_cast<unsigned long long>(reader.rowCount()),
+                static_cast<unsigned long long>(episodes), static_cast<unsigned long long>(finished),
+                rowCount > 0 ? jumpingRows * 100.0 / rowCount : 0.0,
+                rowCount > 0 ? duckingRows * 100.0 / rowCount : 0.0,
+                finished ? static_cast<double>(finalScoreSum) / finished : 0.0);
+    // 最近障碍物的种类分布（按 ObstacleKind）
+    std::printf("  nearest obstacle kind rows:");
+    for (int k = 0; k < ObstacleConstants::KIND_COUNT; k++) {
+        std::printf(" %d=%llu", k, static_cast<unsigned long long>(kindRows[k]));
+    }
+    std::printf("\n");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* directory = ".";
+    int threads = 4;
+    int episodes = 1000;
+    uint32_t baseSeed = 1;
+    bool autoplay = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--inspect") == 0 && i + 1 < argc) {
+            return inspect(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            directory = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+            if (threads < 1) threads = 1;
+        } else if (std::strcmp(argv[i], "--episodes") == 0 && i + 1 < argc) {
+            episodes = std::atoi(argv[++i]);
+            if (episodes < 1) episodes = 1;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            baseSeed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--autoplay") == 0) {
+            autoplay = true;
+        } else {
+            std::fprintf(stderr, "用法: %s [--out 目录] [--threads N] [--episodes 每线程局数] [--seed 起始种子] [--autoplay]\n"
+                                 "      %s --inspect 文件\n", argv[0], argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<ShardResult> results(threads);
+    std::vector<std::thread> workers;
+    auto begin = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        results[t].rows = 0;
+        results[t].stalls = 0;
+        workers.push_back(std::thread(runShard, directory, t, episodes, baseSeed, autoplay, &results[t]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    uint64_t totalRows = 0;
+    uint64_t totalStalls = 0;
+    for (int t = 0; t < threads; t++) {
+        totalRows += results[t].rows;
+        totalStalls += results[t].stalls;
+    }
+    int failedShards = 0;
+    for (int t = 0; t < threads; t++) {
+        if (!results[t].ok) {
+            std::fprintf(stderr, "分片 %d 写入失败（目录: %s），已写入 %llu 行\n", t, directory,
+                         static_cast<unsigned long long>(results[t].rows));
+            failedShards++;
+        }
+    }
+
+    std::printf("threads=%d episodes=%d rows=%llu time=%.2fs (%.0f rows/s) writer stalls=%llu\n", threads,
+                threads * episodes, static_cast<unsigned long long>(totalRows), elapsed.count(),
+                totalRows / elapsed.count(), static_cast<unsigned long long>(totalStalls));
+    return failedShards == 0 ? 0 : 1;
+}
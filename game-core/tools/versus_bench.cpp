@@ -0,0 +1,183 @@
+// 对战回滚测量：两个 VersusSession 经进程内回环（带延迟与抖动）对战多局，
+// 统计回滚次数与深度、回滚耗时分布（恢复快照 + 重新模拟）、快照保存/恢复的开销，
+// 并检查双方对同一玩家的模拟结果是否一致（不一致即为不同步）。
+//
+// 用法: versus_bench [--matches N] [--latency 帧] [--jitter 帧] [--seed 起始种子]
+
+#include "EngineSnapshot.hpp"
+#include "GameEngine.hpp"
+#include "InputTransport.hpp"
+#include "ObstacleManager.hpp"
+#include "Random.hpp"
+#include "VersusSession.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_FRAMES = 30000;
+
+// 简单的“玩家”：前方最近的障碍物进入反应距离时起跳，反应距离随机；
+// 到达 giveUpTick 后不再操作，使每局都会结束
+void playerInput(GameEngine& engine, VersusSession& session, Random& random, int giveUpTick) {
+    GameEngine::RenderState state = engine.getStateForRender();
+    if (state.gameState != 1 || state.dino.isJumping || engine.getTickCount() >= giveUpTick) return;
+
+    float dinoRight = state.dino.x + state.dino.width;
+    for (const auto& obs : *state.obstacles) {
+        float obsX = toFloat(obs.x);
+        if (obsX + obs.width <= state.dino.x || obs.kind == OBSTACLE_BIRD_HIGH) continue;
+
+        float reaction = state.gameSpeed * static_cast<float>(6 + random.nextInt(10));
+        if (obsX - dinoRight < reaction) {
+            session.jump();
+        }
+        break;
+    }
+}
+
+double percentile(std::vector<float>& samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+    return samples[rank];
+}
+
+// 保存/恢复快照的开销：在一局中途的引擎上重复多次取平均
+void measureSnapshot(double& saveNs, double& loadNs) {
+    GameEngine engine;
+    engine.setSeed(7);
+    engine.setAutoplay(true);
+    engine.reset();
+    engine.start();
+    for (int i = 0; i < 3000; i++) {
+        engine.tick();
+    }
+
+    EngineSnapshot snapshot;
+    constexpr int ITERATIONS = 200000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        engine.saveSnapshot(snapshot);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        engine.loadSnapshot(snapshot);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    saveNs = std::chrono::duration<double, std::nano>(middle - begin).count() / ITERATIONS;
+    loadNs = std::chrono::duration<double, std::nano>(end - middle).count() / ITERATIONS;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int matches = 200;
+    int latency = 3;
+    int jitter = 3;
+    uint32_t baseSeed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--matches") == 0 && i + 1 < argc) {
+            matches = std::atoi(argv[++i]);
+            if (matches < 1) matches = 1;
+        } else if (std::strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+            latency = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) {
+            jitter = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            baseSeed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "用法: %s [--matches N] [--latency 帧] [--jitter 帧] [--seed 起始种子]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    GameEngine players[2];
+    VersusSession sessions[2];
+    Random random(baseSeed ^ 0xC0FFEEu);
+    std::vector<float> rollbackMs;
+    int rollbacks = 0;
+    int resimulated = 0;
+    int maxDepth = 0;
+    int stalled = 0;
+    int desyncs = 0;
+    int unfinished = 0;
+    uint64_t ticks = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int m = 0; m < matches; m++) {
+        LoopbackTransport transports[2];
+        LoopbackTransport::connect(transports[0], transports[1]);
+        uint32_t seed = baseSeed + static_cast<uint32_t>(m);
+        for (int side = 0; side < 2; side++) {
+            sessions[side].start(&players[side], &transports[side], seed);
+        }
+
+        int giveUpTicks[2] = {300 + random.nextInt(5000), 300 + random.nextInt(5000)};
+        float now = 0.0f;
+        int frame = 0;
+        for (; frame < MAX_FRAMES; frame++) {
+            now += FIXED_STEP_MS;
+            for (int side = 0; side < 2; side++) {
+                transports[side].setLatency(latency + (jitter > 0 ? random.nextInt(jitter + 1) : 0));
+                playerInput(players[side], sessions[side], random, giveUpTicks[side]);
+
+                int before = sessions[side].getStats().rollbacks;
+                sessions[side].update(now);
+                if (sessions[side].getStats().rollbacks != before) {
+                    rollbackMs.push_back(sessions[side].getStats().lastRollbackMs);
+                }
+                transports[side].advance();
+            }
+            if (sessions[0].getOutcome() != VERSUS_PENDING && sessions[1].getOutcome() != VERSUS_PENDING &&
+                players[0].getStateForRender().gameState == 2 && players[1].getStateForRender().gameState == 2 &&
+                sessions[0].getRemote().getStateForRender().gameState == 2 &&
+                sessions[1].getRemote().getStateForRender().gameState == 2) {
+                break;
+            }
+        }
+        bool finished = frame < MAX_FRAMES;
+        if (!finished) {
+            unfinished++;
+        }
+
+        // 双方对同一玩家的模拟结果必须一致
+        for (int side = 0; side < 2; side++) {
+            GameEngine& remoteView = sessions[1 - side].getRemote();
+            if (finished && (remoteView.getTickCount() != players[side].getTickCount() ||
+                             remoteView.getScore() != players[side].getScore())) {
+                desyncs++;
+            }
+            const VersusSession::Stats& stats = sessions[side].getStats();
+            rollbacks += stats.rollbacks;
+            resimulated += stats.resimulatedTicks;
+            stalled += stats.stalledFrames;
+            if (stats.maxRollbackDepth > maxDepth) maxDepth = stats.maxRollbackDepth;
+            ticks += static_cast<uint64_t>(players[side].getTickCount());
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    double saveNs = 0.0;
+    double loadNs = 0.0;
+    measureSnapshot(saveNs, loadNs);
+
+    std::printf("matches=%d latency=%d+%d frames ticks=%llu time=%.2fs unfinished=%d desyncs=%d\n", matches,
+                latency, jitter, static_cast<unsigned long long>(ticks), elapsed.count(), unfinished, desyncs);
+    std::printf("rollbacks=%d mean depth=%.2f max depth=%d stalled frames=%d\n", rollbacks,
+                rollbacks ? static_cast<double>(resimulated) / rollbacks : 0.0, maxDepth, stalled);
+    std::printf("rollback time p50=%.4fms p99=%.4fms max=%.4fms (frame budget %.2fms)\n",
+                percentile(rollbackMs, 0.5), percentile(rollbackMs, 0.99), percentile(rollbackMs, 1.0),
+                FIXED_STEP_MS);
+    std::printf("snapshot save=%.0fns load=%.0fns (sizeof=%zu bytes + vectors)\n", saveNs, loadNs,
+                sizeof(EngineSnapshot));
+    return desyncs == 0 ? 0 : 1;
+}